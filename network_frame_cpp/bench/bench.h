@@ -0,0 +1,125 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace bench {
+
+// 阻止编译器优化掉被测结果
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// 运行参数
+struct Options {
+    double warmupMs = 20;       // 每项预热时间
+    double minTimeMs = 50;      // 每轮最短测量时间
+    int repeats = 5;            // 重复轮数，取中位数
+    std::string filter;         // 只运行名称包含该子串的项
+    bool json = false;          // 以JSON输出
+};
+
+// 单项结果
+struct Result {
+    std::string name;
+    size_t payload;        // 载荷大小
+    size_t bytes;          // 每次操作处理的字节数（用于计算GB/s）
+    uint64_t iterations;   // 每轮迭代次数
+    double nsPerOp;        // 各轮中位数
+    double minNsPerOp;     // 各轮最小值
+
+    double mpps() const { return nsPerOp > 0 ? 1e3 / nsPerOp : 0; }
+    double gbps() const { return nsPerOp > 0 ? static_cast<double>(bytes) / nsPerOp : 0; }
+};
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : options_(options) {}
+
+    bool selected(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // 测量fn的单次耗时；fn的返回值会被保留以防被优化掉
+    template <typename Fn>
+    void run(const std::string& name, size_t bytes, Fn&& fn) {
+        run(name, bytes, bytes, fn);
+    }
+
+    template <typename Fn>
+    void run(const std::string& name, size_t payload, size_t bytes, Fn&& fn) {
+        if (!selected(name)) {
+            return;
+        }
+        using Clock = std::chrono::steady_clock;
+        
+        // 预热并估算满足最短测量时间所需的迭代次数
+        uint64_t iterations = 1;
+        auto warmupStart = Clock::now();
+        for (;;) {
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(fn());
+            }
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            double total = std::chrono::duration<double, std::milli>(Clock::now() - warmupStart).count();
+            if (ms >= options_.minTimeMs || (total >= options_.warmupMs && ms * 2 >= options_.minTimeMs)) {
+                break;
+            }
+            iterations *= 2;
+        }
+        
+        std::vector<double> samples;
+        for (int r = 0; r < options_.repeats; ++r) {
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(fn());
+            }
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            samples.push_back(ns / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        
+        Result result;
+        result.name = name;
+        result.payload = payload;
+        result.bytes = bytes;
+        result.iterations = iterations;
+        result.nsPerOp = samples[samples.size() / 2];
+        result.minNsPerOp = samples.front();
+        results_.push_back(result);
+        if (!options_.json) {
+            print(result);
+        }
+    }
+
+    // 记录失败的正确性检查
+    void fail(const std::string& message);
+    bool failed() const { return !failures_.empty(); }
+
+    void print(const Result& result) const;
+    void printJson() const;
+
+    const Options& options() const { return options_; }
+
+private:
+    Options options_;
+    std::vector<Result> results_;
+    std::vector<std::string> failures_;
+};
+
+// 各组基准测试
+void runChecksumBenchmarks(Runner& runner);
+void runLayerBenchmarks(Runner& runner);
+
+// 覆盖的载荷大小（0到巨型帧）
+const std::vector<size_t>& payloadSizes();
+
+} // namespace bench
+
+#endif // BENCH_H
@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include "common/checksum.h"
+#include "bench.h"
+
+namespace bench {
+
+const std::vector<size_t>& payloadSizes() {
+    static const std::vector<size_t> sizes = {0, 64, 512, 1472, 4096, 9000};
+    return sizes;
+}
+
+void Runner::fail(const std::string& message) {
+    std::fprintf(stderr, "FAILED: %s\n", message.c_str());
+    failures_.push_back(message);
+}
+
+void Runner::print(const Result& result) const {
+    std::printf("%-28s %6zu B payload %6zu B/op %11.2f ns/op %9.3f Mpps %8.3f GB/s\n",
+                result.name.c_str(), result.payload, result.bytes, result.nsPerOp,
+                result.mpps(), result.gbps());
+}
+
+void Runner::printJson() const {
+    std::printf("{\n  \"checksum_implementation\": \"%s\",\n  \"results\": [\n",
+                common::checksumImplementation());
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const Result& r = results_[i];
+        std::printf("    {\"name\": \"%s\", \"payload\": %zu, \"bytes\": %zu, \"iterations\": %llu, "
+                    "\"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"mpps\": %.4f, \"gbps\": %.4f}%s\n",
+                    r.name.c_str(), r.payload, r.bytes, static_cast<unsigned long long>(r.iterations),
+                    r.nsPerOp, r.minNsPerOp, r.mpps(), r.gbps(), i + 1 < results_.size() ? "," : "");
+    }
+    std::printf("  ],\n  \"repeats\": %d,\n  \"failures\": %zu\n}\n",
+                options_.repeats, failures_.size());
+}
+
+} // namespace bench
+
+namespace {
+
+void printUsage() {
+    std::printf("Usage: network_frame_bench [options]\n"
+                "  --json             Print results as JSON\n"
+                "  --filter=TEXT      Only run benchmarks whose name contains TEXT\n"
+                "  --repeats=N        Measurement rounds per benchmark (median reported, default 5)\n"
+                "  --min-time-ms=MS   Minimum duration of one round (default 50)\n"
+                "  --warmup-ms=MS     Warmup time per benchmark (default 20)\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            options.json = true;
+        } else if (arg.compare(0, 9, "--filter=") == 0) {
+            options.filter = arg.substr(9);
+        } else if (arg.compare(0, 10, "--repeats=") == 0) {
+            options.repeats = std::max(1, std::atoi(arg.c_str() + 10));
+        } else if (arg.compare(0, 14, "--min-time-ms=") == 0) {
+            options.minTimeMs = std::atof(arg.c_str() + 14);
+        } else if (arg.compare(0, 12, "--warmup-ms=") == 0) {
+            options.warmupMs = std::atof(arg.c_str() + 12);
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    
+    bench::Runner runner(options);
+    bench::runChecksumBenchmarks(runner);
+    bench::runLayerBenchmarks(runner);
+    
+    if (options.json) {
+        runner.printJson();
+    }
+    return runner.failed() ? 1 : 0;
+}
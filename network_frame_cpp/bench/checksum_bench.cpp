@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/checksum.h"
+#include "bench.h"
+
+namespace {
+
+// 原IPv4Packet::calculateChecksum实现：先拷贝首部，再逐对字节累加
+uint16_t referenceChecksum(const uint8_t* data, size_t len) {
+    std::vector<uint8_t> header(data, data + len);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < header.size(); i += 2) {
+        uint16_t word = (static_cast<uint16_t>(header[i]) << 8);
+        if (i + 1 < header.size()) {
+            word |= header[i + 1];
+        }
+        sum += word;
+    }
+    while (sum > 0xFFFF) {
+        sum = (sum >> 16) + (sum & 0xFFFF);
+    }
+    return ~static_cast<uint16_t>(sum);
+}
+
+} // namespace
+
+namespace bench {
+
+void runChecksumBenchmarks(Runner& runner) {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> data(65536);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    const uint8_t* p = data.data();
+    
+    if (!runner.options().json) {
+        std::printf("Checksum implementation selected: %s\n\n", common::checksumImplementation());
+    }
+    
+    const size_t sizes[] = {20, 21, 64, 256, 1500, 9000, 65535};
+    for (size_t len : sizes) {
+        // 所有实现的结果必须与原实现一致
+        uint16_t expected = referenceChecksum(p, len);
+        bool ok = common::checksum(p, len) == expected &&
+                  common::checksumFinish(common::checksumPartialScalar(p, len, 0)) == expected;
+        if (common::checksumHasSSE2()) {
+            ok = ok && common::checksumFinish(common::checksumPartialSSE2(p, len, 0)) == expected;
+        }
+        if (common::checksumHasAVX2()) {
+            ok = ok && common::checksumFinish(common::checksumPartialAVX2(p, len, 0)) == expected;
+        }
+        if (!ok) {
+            runner.fail("checksum mismatch at " + std::to_string(len) + " bytes");
+            continue;
+        }
+        
+        runner.run("checksum/reference", len, [&] { return referenceChecksum(p, len); });
+        runner.run("checksum/scalar", len, [&] { return common::checksumPartialScalar(p, len, 0); });
+        if (common::checksumHasSSE2()) {
+            runner.run("checksum/sse2", len, [&] { return common::checksumPartialSSE2(p, len, 0); });
+        }
+        if (common::checksumHasAVX2()) {
+            runner.run("checksum/avx2", len, [&] { return common::checksumPartialAVX2(p, len, 0); });
+        }
+        runner.run("checksum/dispatch", len, [&] { return common::checksum(p, len); });
+    }
+    
+    // 融合拷贝与校验和（发送端载荷拷贝路径）
+    std::vector<uint8_t> copyBuffer(data.size());
+    for (size_t len : payloadSizes()) {
+        runner.run("checksum/copy", len, [&] { return common::checksumCopy(copyBuffer.data(), p, len); });
+    }
+    
+    // 增量更新与整首部重算对比（模拟修改IPv4标识字段）
+    std::vector<uint8_t> header(data.begin(), data.begin() + 20);
+    header[10] = 0;
+    header[11] = 0;
+    uint16_t headerChecksum = common::checksum(header.data(), header.size());
+    uint16_t id = static_cast<uint16_t>((header[4] << 8) | header[5]);
+    uint32_t src = (static_cast<uint32_t>(header[12]) << 24) | (header[13] << 16) | (header[14] << 8) | header[15];
+    header[4] = 0x12;
+    header[5] = 0x34;
+    header[12] = 10;
+    header[13] = 0;
+    header[14] = 0;
+    header[15] = 1;
+    uint16_t updated = common::checksumUpdate16(headerChecksum, id, 0x1234);
+    updated = common::checksumUpdate32(updated, src, 0x0A000001);
+    if (updated != common::checksum(header.data(), header.size())) {
+        runner.fail("incremental checksum mismatch");
+        return;
+    }
+    id = 0x1234;
+    runner.run("checksum/full-ipv4", 20, [&] {
+        header[4] = static_cast<uint8_t>(id >> 8);
+        header[5] = static_cast<uint8_t>(++id);
+        return common::checksum(header.data(), header.size());
+    });
+    runner.run("checksum/rfc1624", 20, [&] {
+        uint16_t next = static_cast<uint16_t>(id + 1);
+        headerChecksum = common::checksumUpdate16(headerChecksum, id, next);
+        id = next;
+        return headerChecksum;
+    });
+}
+
+} // namespace bench
@@ -0,0 +1,324 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "application/application.h"
+#include "transport/udp.h"
+#include "transport/tcp.h"
+#include "network/ipv4.h"
+#include "datalink/ethernet.h"
+#include "sender/sender.h"
+#include "receiver/receiver.h"
+#include "common/buffer_pool.h"
+#include "filter/filter.h"
+#include "demux/demux.h"
+#include "sender/pacer.h"
+#include "io/frame_io.h"
+#include "bench.h"
+
+namespace bench {
+
+namespace {
+
+std::vector<uint8_t> makePayload(size_t size) {
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return payload;
+}
+
+void runUdp(Runner& runner, const sender::Config& config, size_t size) {
+    transport::UDPDatagram udp(config.srcPort, config.dstPort, makePayload(size));
+    udp.updateChecksum(config.srcIP, config.dstIP);
+    std::vector<uint8_t> encoded = udp.encode();
+    size_t bytes = encoded.size();
+    
+    runner.run("udp/encode", size, bytes, [&] { return udp.encode(); });
+    runner.run("udp/decode", size, bytes, [&] { return transport::UDPDatagram::decode(encoded); });
+    runner.run("udp/view", size, bytes, [&] { return transport::UDPView::parse(encoded); });
+    runner.run("udp/checksum", size, bytes, [&] {
+        return transport::UDPView::parse(encoded).checksumValid(config.srcIP, config.dstIP);
+    });
+}
+
+void runIpv4(Runner& runner, const sender::Config& config, size_t size) {
+    auto ipv4 = network::IPv4Packet::createUDP(config.srcIP, config.dstIP, makePayload(size));
+    std::vector<uint8_t> encoded = ipv4.encode();
+    size_t bytes = encoded.size();
+    
+    runner.run("ipv4/encode", size, bytes, [&] { return ipv4.encode(); });
+    runner.run("ipv4/decode", size, bytes, [&] { return network::IPv4Packet::decode(encoded); });
+    runner.run("ipv4/view", size, bytes, [&] { return network::IPv4View::parse(encoded); });
+}
+
+void runEthernet(Runner& runner, const sender::Config& config, size_t size) {
+    auto frame = datalink::EthernetFrame::createIPv4(config.srcMAC, config.dstMAC, makePayload(size));
+    std::vector<uint8_t> encoded = frame.encode();
+    size_t bytes = encoded.size();
+    
+    runner.run("ethernet/encode", size, bytes, [&] { return frame.encode(); });
+    runner.run("ethernet/decode", size, bytes, [&] { return datalink::EthernetFrame::decode(encoded); });
+    runner.run("ethernet/view", size, bytes, [&] { return datalink::EthernetView::parse(encoded); });
+}
+
+void runStack(Runner& runner, const sender::Config& config, size_t size) {
+    application::Data data(makePayload(size));
+    sender::Sender s(config);
+    std::vector<uint8_t> frame = s.encapsulate(data);
+    size_t bytes = frame.size();
+    
+    receiver::Receiver r;
+    auto parsed = r.decapsulate(frame);
+    if (parsed.applicationData().getPayload() != data.getPayload()) {
+        runner.fail("decapsulate round trip at " + std::to_string(size) + " bytes");
+        return;
+    }
+    
+    receiver::Options trusted;
+    trusted.verifyChecksums = false;
+    receiver::Receiver unverified(trusted);
+    
+    runner.run("sender/encapsulate", size, bytes, [&] { return s.encapsulate(data); });
+    // 解封装结果按需解析：完整路径访问应用层数据，lazy路径只读IPv4首部
+    runner.run("receiver/decapsulate", size, bytes, [&] {
+        return r.decapsulate(frame).applicationData().size();
+    });
+    runner.run("receiver/decapsulate-lazy", size, bytes, [&] {
+        return r.decapsulate(frame).ipv4().protocol();
+    });
+    runner.run("receiver/view", size, bytes, [&] { return r.decapsulateView(frame); });
+    runner.run("receiver/view-noverify", size, bytes, [&] { return unverified.decapsulateView(frame); });
+    
+    // 池化缓冲区：封装与解封装都不分配堆内存，解封装结果引用帧所在的缓冲区
+    common::BufferPoolConfig poolConfig;
+    poolConfig.buffers = 64;
+    poolConfig.bufferSize = 10240;
+    common::BufferPool pool(poolConfig);
+    common::BufferRef pooled = s.encapsulate(data, pool);
+    if (pooled.view().toVector() != frame) {
+        runner.fail("pooled encapsulate at " + std::to_string(size) + " bytes");
+        return;
+    }
+    runner.run("sender/encapsulate-pool", size, bytes, [&] { return s.encapsulate(data, pool); });
+    runner.run("receiver/decapsulate-pool", size, bytes, [&] {
+        return r.decapsulate(pooled).applicationData().size();
+    });
+}
+
+// TCP分段卸载：64KB数据一次切分为MSS大小的报文段，对比逐段独立构造
+void runSegmentation(Runner& runner, const sender::Config& config) {
+    constexpr size_t size = 65536;
+    application::Data data(makePayload(size));
+    sender::Sender s(config);
+    common::FrameBatch batch = s.encapsulateSegments(data, 1000, 1);
+    
+    // 逐段校验首部与校验和，并检查序号连续、拼接后的载荷与原数据一致
+    std::vector<uint8_t> joined;
+    uint32_t expectedSeq = 1000;
+    for (size_t i = 0; i < batch.count(); ++i) {
+        auto ethernet = datalink::EthernetView::parse(batch.frame(i));
+        auto ipv4 = network::IPv4View::parse(ethernet.payload());
+        auto tcp = transport::TCPView::parse(ipv4.payload());
+        if (!ipv4.checksumValid() || !tcp.checksumValid(ipv4.srcIP(), ipv4.dstIP()) ||
+            tcp.seq() != expectedSeq) {
+            runner.fail("tcp segment " + std::to_string(i));
+            return;
+        }
+        expectedSeq += static_cast<uint32_t>(tcp.payload().size());
+        joined.insert(joined.end(), tcp.payload().begin(), tcp.payload().end());
+    }
+    if (joined != data.getPayload()) {
+        runner.fail("tcp segmentation payload");
+        return;
+    }
+    
+    size_t mss = s.mss();
+    runner.run("sender/tso", size, batch.bytes(), [&] { return s.encapsulateSegments(data, 1000, 1); });
+    runner.run("sender/segment-each", size, batch.bytes(), [&] {
+        // 基线：每段各自构造TCP报文段、IPv4数据报与以太网帧
+        size_t bytes = 0;
+        for (size_t offset = 0; offset < size; offset += mss) {
+            common::ByteView part = data.view().subview(offset, std::min(mss, size - offset));
+            std::vector<uint8_t> chunk(part.begin(), part.end());
+            transport::TCPSegment segment(config.srcPort, config.dstPort, static_cast<uint32_t>(1000 + offset),
+                                          1, transport::TCP_FLAG_ACK, chunk);
+            segment.updateChecksum(config.srcIP, config.dstIP);
+            network::IPv4Packet ipv4(config.srcIP, config.dstIP, network::PROTOCOL_TCP, segment.encode());
+            bytes += datalink::EthernetFrame::createIPv4(config.srcMAC, config.dstMAC, ipv4.encode())
+                         .encode().size();
+        }
+        return bytes;
+    });
+}
+
+// UDP分段卸载：64KB数据一次切分为MTU大小的数据报，对比逐个数据报调用encapsulate
+void runDatagramSegmentation(Runner& runner, const sender::Config& config) {
+    constexpr size_t size = 65536;
+    application::Data data(makePayload(size));
+    sender::Sender s(config);
+    common::FrameBatch batch = s.encapsulateDatagrams(data);
+    
+    // 每帧都应能被接收端独立解封装（含校验和验证），拼接后的载荷与原数据一致
+    receiver::Receiver r;
+    std::vector<uint8_t> joined;
+    for (size_t i = 0; i < batch.count(); ++i) {
+        receiver::PacketView view;
+        if (batch.frame(i).size() > datalink::ETHERNET_HEADER_SIZE + config.mtu ||
+            r.tryDecapsulateView(batch.frame(i), view) != common::DecodeStatus::Ok) {
+            runner.fail("udp segment " + std::to_string(i));
+            return;
+        }
+        joined.insert(joined.end(), view.payload.begin(), view.payload.end());
+    }
+    if (joined != data.getPayload()) {
+        runner.fail("udp segmentation payload");
+        return;
+    }
+    
+    size_t segmentSize = s.maxDatagramPayload();
+    std::vector<application::Data> parts;
+    for (size_t offset = 0; offset < size; offset += segmentSize) {
+        common::ByteView part = data.view().subview(offset, std::min(segmentSize, size - offset));
+        parts.emplace_back(std::vector<uint8_t>(part.begin(), part.end()));
+    }
+    runner.run("sender/gso", size, batch.bytes(), [&] { return s.encapsulateDatagrams(data); });
+    runner.run("sender/encapsulate-each", size, batch.bytes(), [&] {
+        // 基线：调用方先切分载荷，再逐个数据报独立封装
+        size_t bytes = 0;
+        for (const auto& part : parts) {
+            bytes += s.encapsulate(part).size();
+        }
+        return bytes;
+    });
+}
+
+// IPv4分片：超过MTU的数据报切分为分片，接收端重组后应得到原数据
+void runFragmentation(Runner& runner, const sender::Config& config) {
+    constexpr size_t size = 32768;
+    application::Data data(makePayload(size));
+    sender::Sender s(config);
+    common::FrameBatch batch = s.encapsulateFragments(data);
+    
+    // 每个分片都不超过MTU，最后一个分片完成重组
+    receiver::Receiver r;
+    receiver::PacketView view;
+    for (size_t i = 0; i < batch.count(); ++i) {
+        if (batch.frame(i).size() > datalink::ETHERNET_HEADER_SIZE + config.mtu ||
+            r.tryDecapsulateView(batch.frame(i), view) != common::DecodeStatus::Ok ||
+            view.pending != (i + 1 < batch.count())) {
+            runner.fail("ipv4 fragment " + std::to_string(i));
+            return;
+        }
+    }
+    if (batch.count() < 2 || std::vector<uint8_t>(view.payload.begin(), view.payload.end()) != data.getPayload()) {
+        runner.fail("ipv4 reassembly payload");
+        return;
+    }
+    
+    runner.run("sender/fragment", size, batch.bytes(), [&] { return s.encapsulateFragments(data); });
+    runner.run("receiver/reassemble", size, batch.bytes(), [&] {
+        size_t bytes = 0;
+        for (size_t i = 0; i < batch.count(); ++i) {
+            r.tryDecapsulateView(batch.frame(i), view);
+            bytes += view.pending ? 0 : view.payload.size();
+        }
+        return bytes;
+    });
+}
+
+// 过滤器在原始帧上的判断开销（不匹配的帧应在几纳秒内被拒绝）
+void runFilter(Runner& runner, const sender::Config& config) {
+    sender::Sender s(config);
+    std::vector<uint8_t> frame = s.encapsulate(application::Data(makePayload(64)));
+    auto reject = filter::Filter::compile("tcp or dst port 53");
+    auto accept = filter::Filter::compile("udp and dst port 80 and src net 192.168.1.0/24 and len < 1514");
+    if (reject.matches(frame) || !accept.matches(frame)) {
+        runner.fail("filter verdicts");
+        return;
+    }
+    runner.run("filter/reject", 64, frame.size(), [&] { return reject.matches(frame); });
+    runner.run("filter/accept", 64, frame.size(), [&] { return accept.matches(frame); });
+}
+
+// 协议分发：已知类型逐层查表识别，未知以太网类型在第一次查表后即返回
+void runDemux(Runner& runner, const sender::Config& config) {
+    sender::Sender s(config);
+    std::vector<uint8_t> frame = s.encapsulate(application::Data(makePayload(64)));
+    std::vector<uint8_t> unknown = frame;
+    unknown[12] = 0x88;
+    unknown[13] = 0xCC;
+    
+    demux::Demux table;
+    demux::Packet packet;
+    if (table.process(frame, packet) != demux::Result::Ok || packet.dstPort != config.dstPort ||
+        table.process(unknown, packet) != demux::Result::UnknownEtherType) {
+        runner.fail("demux verdicts");
+        return;
+    }
+    runner.run("demux/udp", 64, frame.size(), [&] { return table.process(frame, packet); });
+    runner.run("demux/unknown", 64, unknown.size(), [&] { return table.process(unknown, packet); });
+}
+
+// 畸形帧的拒绝开销：返回状态码与抛出异常两种接口
+void runReject(Runner& runner, const sender::Config& config) {
+    sender::Sender s(config);
+    std::vector<uint8_t> junk = s.encapsulate(application::Data(makePayload(64)));
+    junk[datalink::ETHERNET_HEADER_SIZE] = 0x65;  // IP版本6
+    
+    receiver::Receiver r;
+    receiver::PacketView view;
+    if (r.tryDecapsulateView(junk, view) != common::DecodeStatus::BadIPVersion) {
+        runner.fail("reject status");
+        return;
+    }
+    runner.run("receiver/reject-status", 64, junk.size(), [&] { return r.tryDecapsulateView(junk, view); });
+    runner.run("receiver/reject-throw", 64, junk.size(), [&] {
+        try {
+            return r.decapsulateView(junk).payload.size();
+        } catch (const std::runtime_error&) {
+            return size_t(0);
+        }
+    });
+}
+
+// 限速发送：实际速率应在RATE_TOLERANCE内跟随请求速率（只做校验，不计时）
+void runPacing(Runner& runner, const sender::Config& config) {
+    if (!runner.selected("pacer/rate")) {
+        return;
+    }
+    sender::Sender s(config);
+    sender::Pacer pacer;
+    sender::FlowRate rate;
+    rate.rate = 200000;
+    pacer.addFlow(s.encapsulate(application::Data(makePayload(64))), rate);
+    io::NullWriter out;
+    sender::PacerStats stats = pacer.run(out, 40000);
+    if (!stats.rateWithin()) {
+        runner.fail("pacer/rate: achieved " + std::to_string(static_cast<uint64_t>(stats.achievedPps())) +
+                    " of " + std::to_string(static_cast<uint64_t>(stats.requestedPps)) + " pps");
+    }
+}
+
+} // namespace
+
+void runLayerBenchmarks(Runner& runner) {
+    // encapsulate不按MTU分片，9000字节载荷按单个巨型帧测量
+    sender::Config config = sender::Sender::defaultConfig();
+    
+    for (size_t size : payloadSizes()) {
+        runUdp(runner, config, size);
+        runIpv4(runner, config, size);
+        runEthernet(runner, config, size);
+        runStack(runner, config, size);
+    }
+    runSegmentation(runner, config);
+    runDatagramSegmentation(runner, config);
+    runFragmentation(runner, config);
+    runFilter(runner, config);
+    runDemux(runner, config);
+    runReject(runner, config);
+    runPacing(runner, config);
+}
+
+} // namespace bench
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include "common/byte_view.h"
+#include "common/byte_storage.h"
 
 namespace application {
 
@@ -13,10 +15,17 @@ public:
     Data() = default;
     explicit Data(const std::string& payload);
     explicit Data(const std::vector<uint8_t>& payload);
+    explicit Data(std::vector<uint8_t>&& payload);
+    explicit Data(common::ByteView payload);
+    // 直接使用已有存储（可引用池化缓冲区，不拷贝）
+    explicit Data(common::ByteStorage payload);
 
     // 获取原始数据
     std::vector<uint8_t> getPayload() const;
     
+    // 获取原始数据视图（不拷贝）
+    common::ByteView view() const { return payload_.view(); }
+    
     // 获取原始数据字符串形式
     std::string getPayloadString() const;
     
@@ -24,7 +33,7 @@ public:
     size_t size() const;
 
 private:
-    std::vector<uint8_t> payload_;
+    common::ByteStorage payload_;
 };
 
 } // namespace application
@@ -0,0 +1,166 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+#include "common/byte_view.h"
+
+namespace common {
+
+struct BufferPoolConfig {
+    size_t buffers = 8192;      // 缓冲区个数
+    size_t bufferSize = 2048;   // 每个缓冲区的字节数（含头部空间），向上取整到64
+    size_t headroom = 128;      // 新分配缓冲区的数据起点
+    size_t cacheSize = 256;     // 每线程缓存的缓冲区个数上限（0表示不缓存）
+    bool hugePages = false;     // 尝试用大页内存（失败时退回普通页）
+};
+
+class BufferPool;
+
+// 缓冲区描述符：引用计数与当前数据范围[head, tail)
+struct BufferDescriptor {
+    std::atomic<uint32_t> refs{0};
+    uint32_t index = 0;
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    uint8_t* base = nullptr;
+    BufferPool* pool = nullptr;
+};
+
+// 池化缓冲区的引用计数句柄（类似mbuf）
+//
+// 拷贝句柄只增加引用计数，最后一个句柄析构时缓冲区归还缓冲池。
+// 共享同一缓冲区的句柄看到相同的数据范围，修改前应确认refCount()为1。
+class BufferRef {
+public:
+    BufferRef() = default;
+    BufferRef(const BufferRef& other) noexcept : desc_(other.desc_) {
+        if (desc_) {
+            desc_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    BufferRef(BufferRef&& other) noexcept : desc_(other.desc_) { other.desc_ = nullptr; }
+    BufferRef& operator=(BufferRef other) noexcept {
+        std::swap(desc_, other.desc_);
+        return *this;
+    }
+    ~BufferRef() { reset(); }
+
+    // 放弃引用
+    void reset() noexcept;
+
+    explicit operator bool() const noexcept { return desc_ != nullptr; }
+    uint32_t refCount() const noexcept { return desc_ ? desc_->refs.load(std::memory_order_relaxed) : 0; }
+
+    uint8_t* data() noexcept { return desc_->base + desc_->head; }
+    const uint8_t* data() const noexcept { return desc_->base + desc_->head; }
+    size_t size() const noexcept { return desc_->tail - desc_->head; }
+    size_t headroom() const noexcept { return desc_->head; }
+    size_t tailroom() const noexcept;
+    ByteView view() const noexcept { return ByteView(data(), size()); }
+
+    // 在前部预留len字节并返回其起始地址（头部空间不足时抛出异常）
+    uint8_t* prepend(size_t len) {
+        if (len > desc_->head) {
+            throw std::runtime_error("Not enough headroom in pooled buffer");
+        }
+        desc_->head -= static_cast<uint32_t>(len);
+        return desc_->base + desc_->head;
+    }
+
+    // 在尾部追加len字节并返回其起始地址（尾部空间不足时抛出异常）
+    uint8_t* append(size_t len) {
+        if (len > tailroom()) {
+            throw std::runtime_error("Not enough tailroom in pooled buffer");
+        }
+        uint8_t* out = desc_->base + desc_->tail;
+        desc_->tail += static_cast<uint32_t>(len);
+        return out;
+    }
+    void append(ByteView bytes);
+
+    // 从前部/尾部去掉len字节（超过数据长度时截断为空）
+    void trimFront(size_t len) noexcept;
+    void trimBack(size_t len) noexcept;
+
+private:
+    friend class BufferPool;
+    explicit BufferRef(BufferDescriptor* desc) noexcept : desc_(desc) {}
+
+    BufferDescriptor* desc_ = nullptr;
+};
+
+// 固定大小的缓冲池
+//
+// 所有缓冲区在构造时一次性映射，分配与释放优先走每线程缓存（无锁），
+// 缓存空或满时与全局空闲栈成批交换，线程退出时其缓存归还全局栈。
+// 缓冲池必须比它分配出的所有句柄活得久。
+class BufferPool {
+public:
+    explicit BufferPool(const BufferPoolConfig& config = BufferPoolConfig());
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // 分配一个数据为空、起点在headroom处的缓冲区（耗尽时抛出异常）
+    BufferRef allocate();
+
+    // 耗尽时返回空句柄
+    BufferRef tryAllocate();
+
+    size_t capacity() const { return config_.buffers; }
+    size_t bufferSize() const { return stride_; }
+    size_t headroom() const { return config_.headroom; }
+    bool hugePages() const { return hugePages_; }
+
+    // 全局空闲栈中的缓冲区数（不含各线程缓存）
+    size_t available() const;
+
+private:
+    friend class BufferRef;
+
+    // 每线程缓存，按线程编号固定分配，只被所属线程访问
+    struct alignas(64) ThreadCache {
+        std::vector<uint32_t> items;
+        size_t count = 0;
+    };
+    
+    // 线程编号的分配与回收（定义见源文件）
+    struct ThreadSlot;
+
+    BufferPoolConfig config_;
+    size_t stride_;
+    size_t mappedSize_;
+    uint8_t* memory_;
+    bool hugePages_;
+    std::unique_ptr<BufferDescriptor[]> descriptors_;
+    std::unique_ptr<ThreadCache[]> caches_;
+
+    mutable std::mutex mutex_;
+    std::vector<uint32_t> free_;
+
+    void release(BufferDescriptor* desc);
+    ThreadCache* localCache();
+    void flushCache(size_t slot);
+};
+
+inline void BufferRef::reset() noexcept {
+    if (desc_ && desc_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        desc_->pool->release(desc_);
+    }
+    desc_ = nullptr;
+}
+
+inline size_t BufferRef::tailroom() const noexcept {
+    return desc_->pool->stride_ - desc_->tail;
+}
+
+} // namespace common
+
+#endif // BUFFER_POOL_H
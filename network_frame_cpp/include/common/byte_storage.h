@@ -0,0 +1,48 @@
+#ifndef BYTE_STORAGE_H
+#define BYTE_STORAGE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "common/byte_view.h"
+#include "common/buffer_pool.h"
+
+namespace common {
+
+// 载荷存储：自有的字节数组，或引用池化缓冲区中的一段（不拷贝、不分配）
+class ByteStorage {
+public:
+    ByteStorage() = default;
+    explicit ByteStorage(std::vector<uint8_t> bytes) : owned_(std::move(bytes)) {}
+    explicit ByteStorage(ByteView bytes) : owned_(bytes.begin(), bytes.end()) {}
+
+    // 引用buffer中从当前数据起点偏移offset处开始的size字节
+    ByteStorage(BufferRef buffer, size_t offset, size_t size)
+        : buffer_(std::move(buffer)), offset_(offset), size_(size) {}
+
+    ByteView view() const {
+        return buffer_ ? ByteView(buffer_.data() + offset_, size_) : ByteView(owned_);
+    }
+    size_t size() const { return buffer_ ? size_ : owned_.size(); }
+    bool pooled() const { return static_cast<bool>(buffer_); }
+
+    std::vector<uint8_t> toVector() const { return view().toVector(); }
+
+    // 取[offset, offset+size)：池化存储返回引用同一缓冲区的存储，否则拷贝
+    ByteStorage slice(size_t offset, size_t size) const {
+        if (buffer_) {
+            return ByteStorage(buffer_, offset_ + offset, size);
+        }
+        return ByteStorage(view().subview(offset, size));
+    }
+
+private:
+    std::vector<uint8_t> owned_;
+    BufferRef buffer_;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace common
+
+#endif // BYTE_STORAGE_H
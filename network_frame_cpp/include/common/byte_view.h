@@ -0,0 +1,94 @@
+#ifndef BYTE_VIEW_H
+#define BYTE_VIEW_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+namespace common {
+
+// 只读字节视图（不持有内存，调用方保证底层缓冲区有效）
+class ByteView {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    constexpr ByteView() noexcept = default;
+    constexpr ByteView(const uint8_t* data, size_t size) noexcept
+        : data_(data), size_(size) {}
+    ByteView(const std::vector<uint8_t>& bytes) noexcept
+        : data_(bytes.data()), size_(bytes.size()) {}
+
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const uint8_t* begin() const noexcept { return data_; }
+    const uint8_t* end() const noexcept { return data_ + size_; }
+    uint8_t operator[](size_t index) const noexcept { return data_[index]; }
+
+    // 截取子视图，超出范围的部分被截断
+    ByteView subview(size_t offset, size_t count = npos) const noexcept {
+        if (offset > size_) {
+            offset = size_;
+        }
+        size_t remaining = size_ - offset;
+        return ByteView(data_ + offset, count < remaining ? count : remaining);
+    }
+
+    // 拷贝为字节数组
+    std::vector<uint8_t> toVector() const {
+        return std::vector<uint8_t>(begin(), end());
+    }
+
+    // 拷贝为字符串
+    std::string toString() const {
+        return std::string(reinterpret_cast<const char*>(data_), size_);
+    }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// 大端（网络字节序）读写
+inline uint16_t loadBE16(const uint8_t* p) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+inline uint32_t loadBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline void storeBE16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value >> 8);
+    p[1] = static_cast<uint8_t>(value);
+}
+
+inline void storeBE32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value >> 24);
+    p[1] = static_cast<uint8_t>(value >> 16);
+    p[2] = static_cast<uint8_t>(value >> 8);
+    p[3] = static_cast<uint8_t>(value);
+}
+
+// 小端写入（导出文件等主机侧格式）
+inline void storeLE16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void storeLE32(uint8_t* p, uint32_t value) {
+    storeLE16(p, static_cast<uint16_t>(value));
+    storeLE16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+inline void storeLE64(uint8_t* p, uint64_t value) {
+    storeLE32(p, static_cast<uint32_t>(value));
+    storeLE32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+} // namespace common
+
+#endif // BYTE_VIEW_H
@@ -0,0 +1,54 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace common {
+
+// Internet校验和（RFC 1071）
+//
+// 部分和（partial）为尚未取反的反码和，以网络字节序的16位字表示，
+// 可以跨多段数据累加；除最后一段外，每段长度必须为偶数。
+
+// 累加一段数据，返回新的部分和（自动选择最快的实现）
+uint32_t checksumPartial(const uint8_t* data, size_t len, uint32_t initial = 0);
+
+// 拷贝一段数据并同时累加（数据只读一遍），返回新的部分和
+uint32_t checksumCopy(uint8_t* dst, const uint8_t* src, size_t len, uint32_t initial = 0);
+
+// 折叠部分和并取反，得到最终校验和
+uint16_t checksumFinish(uint32_t partial);
+
+// 计算一段数据的校验和
+inline uint16_t checksum(const uint8_t* data, size_t len) {
+    return checksumFinish(checksumPartial(data, len));
+}
+
+// 合并两个部分和
+inline uint32_t checksumAdd(uint32_t a, uint32_t b) {
+    uint64_t sum = static_cast<uint64_t>(a) + b;
+    return static_cast<uint32_t>((sum & 0xFFFFFFFF) + (sum >> 32));
+}
+
+// 增量更新（RFC 1624 式3）：某个16位字由oldValue变为newValue后的新校验和
+uint16_t checksumUpdate16(uint16_t oldChecksum, uint16_t oldValue, uint16_t newValue);
+
+// 增量更新：32位字段（如IPv4地址）变化后的新校验和
+uint16_t checksumUpdate32(uint16_t oldChecksum, uint32_t oldValue, uint32_t newValue);
+
+// 各实现（供基准测试对比，调用方需自行确认CPU支持）
+uint32_t checksumPartialScalar(const uint8_t* data, size_t len, uint32_t initial);
+uint32_t checksumPartialSSE2(const uint8_t* data, size_t len, uint32_t initial);
+uint32_t checksumPartialAVX2(const uint8_t* data, size_t len, uint32_t initial);
+
+// 当前CPU是否支持对应实现
+bool checksumHasSSE2();
+bool checksumHasAVX2();
+
+// 运行时选中的实现名称："scalar"、"sse2"或"avx2"
+const char* checksumImplementation();
+
+} // namespace common
+
+#endif // CHECKSUM_H
@@ -0,0 +1,22 @@
+#ifndef CPU_RELAX_H
+#define CPU_RELAX_H
+
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace common {
+
+// 自旋等待时提示CPU让出流水线资源（x86为pause，其他平台让出线程）
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+} // namespace common
+
+#endif // CPU_RELAX_H
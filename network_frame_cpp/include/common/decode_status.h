@@ -0,0 +1,72 @@
+#ifndef DECODE_STATUS_H
+#define DECODE_STATUS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace common {
+
+// 解码结果（tryParse/tryDecode系列接口不抛出异常，以此说明失败原因）
+enum class DecodeStatus : uint8_t {
+    Ok = 0,
+    EthernetTooShort,    // 不足以太网首部长度
+    NotIP,               // EtherType不是IPv4或IPv6
+    IPv4TooShort,        // 不足IPv4最小首部长度
+    BadIPVersion,        // 版本号与首部类型不符
+    BadIPHeaderLength,   // IHL小于5或超出数据长度
+    BadIPTotalLength,    // 总长度小于首部长度或超出数据长度
+    BadIPChecksum,       // IPv4首部校验和错误
+    FragmentRejected,    // 关闭重组时收到分片
+    IPv6TooShort,        // 不足IPv6固定首部长度
+    BadIPv6PayloadLength,// 载荷长度超出数据长度
+    BadIPv6Extension,    // 扩展首部截断、顺序非法或超过遍历上限
+    IPv6Fragment,        // IPv6分片（不支持重组）
+    NotUDP,              // 协议号不是UDP
+    UDPTooShort,         // 不足UDP首部长度
+    BadUDPLength,        // UDP长度字段非法
+    BadUDPChecksum,      // UDP校验和错误
+    TCPTooShort,         // 不足TCP最小首部长度
+    BadTCPDataOffset,    // 数据偏移小于5或超出数据长度
+    Filtered,            // 被过滤器拒绝
+    Incomplete,          // 分片数据报尚未重组完成
+    Count
+};
+
+constexpr size_t DECODE_STATUS_COUNT = static_cast<size_t>(DecodeStatus::Count);
+
+// 简短名称（用于统计输出）
+const char* decodeStatusName(DecodeStatus status);
+
+// 与异常接口一致的错误信息
+const char* decodeStatusMessage(DecodeStatus status);
+
+// 异常接口的包装：以decodeStatusMessage抛出std::runtime_error（不内联，保持调用点精简）
+[[noreturn]] void throwDecodeError(DecodeStatus status);
+
+// 按原因分类的丢弃计数
+struct DropCounters {
+    std::array<uint64_t, DECODE_STATUS_COUNT> counts{};
+
+    void add(DecodeStatus status) { ++counts[static_cast<size_t>(status)]; }
+    uint64_t operator[](DecodeStatus status) const { return counts[static_cast<size_t>(status)]; }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (uint64_t count : counts) {
+            sum += count;
+        }
+        return sum;
+    }
+
+    DropCounters& operator+=(const DropCounters& other) {
+        for (size_t i = 0; i < DECODE_STATUS_COUNT; ++i) {
+            counts[i] += other.counts[i];
+        }
+        return *this;
+    }
+};
+
+} // namespace common
+
+#endif // DECODE_STATUS_H
@@ -0,0 +1,60 @@
+#ifndef FRAME_BATCH_H
+#define FRAME_BATCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "common/byte_view.h"
+
+namespace common {
+
+// 帧批量缓冲区：所有帧首尾相接存放在一块连续内存中，另有偏移表
+class FrameBatch {
+public:
+    FrameBatch() : offsets_(1, 0) {}
+
+    // 预留帧数和总字节数，避免追加时重新分配
+    void reserve(size_t frames, size_t bytes) {
+        offsets_.reserve(frames + 1);
+        arena_.reserve(bytes);
+    }
+
+    // 在末尾追加一个size字节的帧，返回其写入地址
+    uint8_t* appendFrame(size_t size) {
+        size_t offset = arena_.size();
+        arena_.resize(offset + size);
+        offsets_.push_back(offset + size);
+        return arena_.data() + offset;
+    }
+
+    void clear() {
+        arena_.clear();
+        offsets_.resize(1);
+    }
+
+    size_t count() const { return offsets_.size() - 1; }
+    size_t bytes() const { return arena_.size(); }
+    bool empty() const { return count() == 0; }
+
+    // 第index个帧
+    ByteView frame(size_t index) const {
+        return ByteView(arena_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+    }
+
+    // 第index个帧的可写地址（追加新帧后可能失效）
+    uint8_t* frameData(size_t index) {
+        return arena_.data() + offsets_[index];
+    }
+
+    // 整块连续内存与偏移表（count()+1项，第i帧为[offsets[i], offsets[i+1])）
+    ByteView arena() const { return ByteView(arena_); }
+    const std::vector<size_t>& offsets() const { return offsets_; }
+
+private:
+    std::vector<uint8_t> arena_;
+    std::vector<size_t> offsets_;
+};
+
+} // namespace common
+
+#endif // FRAME_BATCH_H
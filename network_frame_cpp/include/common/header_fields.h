@@ -0,0 +1,173 @@
+#ifndef HEADER_FIELDS_H
+#define HEADER_FIELDS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <type_traits>
+
+namespace common {
+
+// 编译期首部字段描述
+//
+// 每个字段只声明一次位置和宽度，读写代码由模板在编译期展开为定长的大端读写，
+// 没有循环和分支。HeaderCodec在编译期检查字段互不重叠且恰好覆盖整个首部。
+
+namespace detail {
+
+// 读写N字节大端整数（N为编译期常量，循环会被完全展开）
+template <size_t N>
+constexpr uint64_t loadBE(const uint8_t* p) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < N; ++i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+template <size_t N>
+constexpr void storeBE(uint8_t* p, uint64_t value) {
+    for (size_t i = 0; i < N; ++i) {
+        p[N - 1 - i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+// 能容纳Bits位的最小无符号整数类型
+template <size_t Bits>
+using UintFor = std::conditional_t<(Bits <= 8), uint8_t,
+                std::conditional_t<(Bits <= 16), uint16_t,
+                std::conditional_t<(Bits <= 32), uint32_t, uint64_t>>>;
+
+} // namespace detail
+
+// 从首部第BitOffset位（最高位为第0位）开始、宽Bits位的大端整数字段
+template <size_t BitOffset, size_t Bits>
+struct BitField {
+    using value_type = detail::UintFor<Bits>;
+
+    static constexpr size_t bitOffset = BitOffset;
+    static constexpr size_t bits = Bits;
+    static constexpr size_t byteOffset = BitOffset / 8;
+    static constexpr size_t span = (BitOffset % 8 + Bits + 7) / 8;
+    static constexpr unsigned shift = static_cast<unsigned>(span * 8 - BitOffset % 8 - Bits);
+    static constexpr uint64_t mask = Bits == 64 ? ~0ULL : (1ULL << Bits) - 1;
+
+    static_assert(Bits > 0, "Field must not be empty");
+    static_assert(span <= 8, "Field must fit in 8 bytes");
+
+    static constexpr value_type get(const uint8_t* header) {
+        return static_cast<value_type>((detail::loadBE<span>(header + byteOffset) >> shift) & mask);
+    }
+
+    // 只改写本字段占用的位，与其他字段共用的字节保持不变
+    static constexpr void set(uint8_t* header, value_type value) {
+        uint64_t bitsValue = static_cast<uint64_t>(value) & mask;
+        if constexpr (BitOffset % 8 == 0 && Bits % 8 == 0) {
+            detail::storeBE<span>(header + byteOffset, bitsValue);
+        } else {
+            uint64_t word = detail::loadBE<span>(header + byteOffset);
+            word = (word & ~(mask << shift)) | (bitsValue << shift);
+            detail::storeBE<span>(header + byteOffset, word);
+        }
+    }
+};
+
+// 从首部第ByteOffset字节开始的N字节原样字段（MAC地址、IP地址等）
+template <size_t ByteOffset, size_t N>
+struct ByteField {
+    using value_type = std::array<uint8_t, N>;
+
+    static constexpr size_t bitOffset = ByteOffset * 8;
+    static constexpr size_t bits = N * 8;
+    static constexpr size_t byteOffset = ByteOffset;
+
+    static constexpr value_type get(const uint8_t* header) {
+        value_type value{};
+        for (size_t i = 0; i < N; ++i) {
+            value[i] = header[ByteOffset + i];
+        }
+        return value;
+    }
+
+    static constexpr void set(uint8_t* header, const value_type& value) {
+        for (size_t i = 0; i < N; ++i) {
+            header[ByteOffset + i] = value[i];
+        }
+    }
+};
+
+// 把首部结构体的成员Member绑定到字段Field
+template <auto Member, typename Field>
+struct Bind {
+    using field = Field;
+
+    template <typename Header>
+    static constexpr void encode(const Header& header, uint8_t* out) {
+        Field::set(out, static_cast<typename Field::value_type>(header.*Member));
+    }
+
+    template <typename Header>
+    static constexpr void decode(Header& header, const uint8_t* in) {
+        using Target = std::remove_reference_t<decltype(header.*Member)>;
+        header.*Member = static_cast<Target>(Field::get(in));
+    }
+};
+
+namespace detail {
+
+struct FieldRange {
+    size_t begin;
+    size_t end;
+};
+
+// 字段按位区间两两不重叠、都在首部内、总位数等于首部位数
+template <size_t N>
+constexpr bool exactCover(const FieldRange (&ranges)[N], size_t totalBits) {
+    size_t covered = 0;
+    for (size_t i = 0; i < N; ++i) {
+        if (ranges[i].end > totalBits) {
+            return false;
+        }
+        for (size_t j = i + 1; j < N; ++j) {
+            if (ranges[i].begin < ranges[j].end && ranges[j].begin < ranges[i].end) {
+                return false;
+            }
+        }
+        covered += ranges[i].end - ranges[i].begin;
+    }
+    return covered == totalBits;
+}
+
+} // namespace detail
+
+// 定长首部编解码：Size字节的首部与结构体Header之间按Binds逐字段转换
+template <typename Header, size_t Size, typename... Binds>
+struct HeaderCodec {
+    static constexpr size_t size = Size;
+
+    static_assert(sizeof...(Binds) > 0, "Header needs at least one field");
+    static_assert(detail::exactCover<sizeof...(Binds)>(
+                      {detail::FieldRange{Binds::field::bitOffset,
+                                          Binds::field::bitOffset + Binds::field::bits}...},
+                      Size * 8),
+                  "Header fields must cover the header exactly once");
+
+    // 写入out起始的Size字节，无需预先清零：先清零再逐字段写入，
+    // 因为非整字节字段的set会读取与相邻字段共用的字节
+    static constexpr void encode(const Header& header, uint8_t* out) {
+        for (size_t i = 0; i < Size; ++i) {
+            out[i] = 0;
+        }
+        (Binds::encode(header, out), ...);
+    }
+
+    static constexpr Header decode(const uint8_t* in) {
+        Header header{};
+        (Binds::decode(header, in), ...);
+        return header;
+    }
+};
+
+} // namespace common
+
+#endif // HEADER_FIELDS_H
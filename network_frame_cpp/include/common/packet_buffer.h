@@ -0,0 +1,42 @@
+#ifndef PACKET_BUFFER_H
+#define PACKET_BUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include "common/byte_view.h"
+
+namespace common {
+
+// 带预留头部空间（headroom）的数据包缓冲区
+// 载荷只写入一次，各层首部依次在前部原地插入
+class PacketBuffer {
+public:
+    PacketBuffer(size_t headroom, size_t payloadCapacity);
+
+    // 在前部预留len字节并返回其起始地址（头部空间不足时抛出异常）
+    uint8_t* prepend(size_t len);
+
+    // 在尾部追加len字节并返回其起始地址
+    uint8_t* append(size_t len);
+    void append(ByteView bytes);
+
+    uint8_t* data() { return storage_.data() + head_; }
+    const uint8_t* data() const { return storage_.data() + head_; }
+    size_t size() const { return tail_ - head_; }
+    size_t headroom() const { return head_; }
+    ByteView view() const { return ByteView(data(), size()); }
+
+    // 取出完整数据包（头部空间恰好用完时不产生拷贝）
+    std::vector<uint8_t> release();
+
+private:
+    std::vector<uint8_t> storage_;
+    size_t head_;
+    size_t tail_;
+};
+
+} // namespace common
+
+#endif // PACKET_BUFFER_H
@@ -0,0 +1,68 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace common {
+
+// 分层时间轮：4层、每层64个槽位，覆盖2^24个刻度，更远的定时器放入溢出表
+//
+// 定时器以小整数id标识（每个id同时最多一个定时器），节点预先分配。
+// 每层用64位位图记录非空槽位，空闲时可按整块跳过。
+class TimingWheel {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+    explicit TimingWheel(size_t maxTimers, uint64_t startTick = 0);
+
+    // 在tick到期时触发id（已过期的tick在下一次advance时立即触发）
+    void schedule(uint32_t id, uint64_t tick);
+
+    void cancel(uint32_t id);
+
+    bool scheduled(uint32_t id) const { return nodes_[id].level != UNSCHEDULED; }
+
+    // 推进到nowTick（含），把到期的id依次追加到expired
+    void advance(uint64_t nowTick, std::vector<uint32_t>& expired);
+
+    // 最早可能到期的刻度的下界（无定时器时返回UINT64_MAX）
+    uint64_t nextTick() const;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint64_t currentTick() const { return current_; }
+
+private:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr uint8_t UNSCHEDULED = 0xFF;
+    static constexpr uint8_t DUE = LEVELS;          // 已过期，等待触发
+    static constexpr uint8_t OVERFLOW = LEVELS + 1;  // 超出时间轮范围
+
+    struct Node {
+        uint64_t tick = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint8_t level = UNSCHEDULED;
+        uint8_t slot = 0;
+    };
+
+    std::vector<Node> nodes_;
+    uint32_t heads_[LEVELS + 2][SLOTS];   // 最后两行分别是到期表和溢出表（只用槽位0）
+    uint64_t occupied_[LEVELS];
+    uint64_t current_;
+    size_t size_;
+
+    void link(uint32_t id, uint8_t level, uint8_t slot);
+    void unlink(uint32_t id);
+    void place(uint32_t id);
+    void cascade(uint8_t level, uint8_t slot);
+    void fire(uint8_t level, uint8_t slot, std::vector<uint32_t>& expired);
+};
+
+} // namespace common
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,46 @@
+#ifndef TOEPLITZ_H
+#define TOEPLITZ_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+namespace common {
+
+constexpr size_t TOEPLITZ_KEY_SIZE = 40;
+constexpr size_t TOEPLITZ_MAX_INPUT = 36;  // IPv6地址对+端口对
+
+// RSS Toeplitz散列
+// 构造时按输入字节位置预先计算查找表，每字节一次查表和异或
+class ToeplitzHash {
+public:
+    using Key = std::array<uint8_t, TOEPLITZ_KEY_SIZE>;
+
+    // 默认使用Microsoft RSS规范中的示例密钥（与多数网卡默认值一致）
+    ToeplitzHash();
+    explicit ToeplitzHash(const Key& key);
+
+    uint32_t hash(const uint8_t* input, size_t len) const;
+
+    // IPv4四元组（地址、端口均为网络字节序字节）
+    uint32_t hashIPv4(const uint8_t* srcIP, const uint8_t* dstIP,
+                      uint16_t srcPort, uint16_t dstPort) const;
+
+    // IPv4二元组（分片等无端口信息时使用）
+    uint32_t hashIPv4(const uint8_t* srcIP, const uint8_t* dstIP) const;
+
+    // IPv6四元组与二元组（地址为16字节）
+    uint32_t hashIPv6(const uint8_t* srcIP, const uint8_t* dstIP,
+                      uint16_t srcPort, uint16_t dstPort) const;
+    uint32_t hashIPv6(const uint8_t* srcIP, const uint8_t* dstIP) const;
+
+    static const Key& defaultKey();
+
+private:
+    std::vector<std::array<uint32_t, 256>> table_;
+};
+
+} // namespace common
+
+#endif // TOEPLITZ_H
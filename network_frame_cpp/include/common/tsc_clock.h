@@ -0,0 +1,59 @@
+#ifndef TSC_CLOCK_H
+#define TSC_CLOCK_H
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace common {
+
+// 基于TSC的纳秒时钟
+//
+// 首次使用时用steady_clock校准TSC频率，之后读时钟只需一条rdtsc和一次定点乘法。
+// CPU不支持不变TSC（或非x86平台）时退回steady_clock。
+class TscClock {
+public:
+    static const TscClock& instance();
+
+    uint64_t nowNs() const {
+#if defined(__x86_64__) || defined(__i386__)
+        if (useTsc_) {
+            uint64_t ticks = __rdtsc() - baseTicks_;
+            return baseNs_ + mulShift32(ticks, nsPerTick_);
+        }
+#endif
+        return steadyNs();
+    }
+
+    bool usingTsc() const { return useTsc_; }
+
+    // TSC频率（GHz），未使用TSC时为0
+    double ghz() const { return ghz_; }
+
+    static uint64_t steadyNs();
+
+private:
+    static constexpr unsigned FIXED_SHIFT = 32;
+
+    // (a * b) >> 32，按32位拆分相乘，不依赖128位整数（32位x86没有__int128）
+    static constexpr uint64_t mulShift32(uint64_t a, uint64_t b) {
+        uint64_t aHi = a >> 32;
+        uint64_t aLo = a & 0xFFFFFFFFu;
+        uint64_t bHi = b >> 32;
+        uint64_t bLo = b & 0xFFFFFFFFu;
+        return ((aHi * bHi) << 32) + aHi * bLo + aLo * bHi + ((aLo * bLo) >> 32);
+    }
+
+    TscClock();
+
+    bool useTsc_ = false;
+    double ghz_ = 0;
+    uint64_t baseTicks_ = 0;
+    uint64_t baseNs_ = 0;
+    uint64_t nsPerTick_ = 0;   // 32.32定点
+};
+
+} // namespace common
+
+#endif // TSC_CLOCK_H
@@ -6,12 +6,23 @@
 #include <string>
 #include <array>
 #include <stdexcept>
+#include "common/byte_view.h"
+#include "common/packet_buffer.h"
+#include "common/byte_storage.h"
+#include "common/header_fields.h"
+#include "common/decode_status.h"
 
 namespace datalink {
 
 constexpr size_t ETHERNET_HEADER_SIZE = 14;
+constexpr size_t ETHERNET_FCS_SIZE = 4;      // 帧校验序列由网卡生成，捕获文件中的帧不含FCS
 constexpr size_t MAC_ADDRESS_SIZE = 6;
 constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+constexpr uint16_t ETHERTYPE_ARP = 0x0806;
+constexpr uint16_t ETHERTYPE_VLAN = 0x8100;   // 802.1Q标签
+constexpr uint16_t ETHERTYPE_QINQ = 0x88A8;   // 802.1ad外层标签
+constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+constexpr size_t VLAN_TAG_SIZE = 4;
 
 // MAC地址类型
 using MACAddress = std::array<uint8_t, 6>;
@@ -23,12 +34,53 @@ struct EthernetHeader {
     uint16_t etherType;
 };
 
+// 以太网首部字段布局
+namespace fields {
+using DstMAC = common::ByteField<0, MAC_ADDRESS_SIZE>;
+using SrcMAC = common::ByteField<6, MAC_ADDRESS_SIZE>;
+using EtherType = common::BitField<96, 16>;
+
+using EthernetCodec = common::HeaderCodec<EthernetHeader, ETHERNET_HEADER_SIZE,
+    common::Bind<&EthernetHeader::dstMAC, DstMAC>,
+    common::Bind<&EthernetHeader::srcMAC, SrcMAC>,
+    common::Bind<&EthernetHeader::etherType, EtherType>>;
+} // namespace fields
+
+// 以太网帧只读视图（原地解析首部，载荷指向原缓冲区）
+class EthernetView {
+public:
+    EthernetView() = default;
+
+    // 解析以太网帧，数据不足时抛出异常
+    static EthernetView parse(common::ByteView frame);
+    // 不抛出异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryParse(common::ByteView frame, EthernetView& out) noexcept;
+
+    MACAddress dstMAC() const { return fields::DstMAC::get(frame_.data()); }
+    MACAddress srcMAC() const { return fields::SrcMAC::get(frame_.data()); }
+    uint16_t etherType() const { return fields::EtherType::get(frame_.data()); }
+    EthernetHeader header() const { return fields::EthernetCodec::decode(frame_.data()); }
+    bool isIPv4() const { return etherType() == ETHERTYPE_IPV4; }
+
+    // 整个帧与有效载荷
+    common::ByteView bytes() const { return frame_; }
+    common::ByteView payload() const { return frame_.subview(ETHERNET_HEADER_SIZE); }
+
+private:
+    explicit EthernetView(common::ByteView frame) : frame_(frame) {}
+
+    common::ByteView frame_;
+};
+
 // 以太网帧类
 class EthernetFrame {
 public:
     EthernetFrame() = default;
     EthernetFrame(const MACAddress& srcMAC, const MACAddress& dstMAC,
                   uint16_t etherType, const std::vector<uint8_t>& payload);
+    explicit EthernetFrame(const EthernetView& view);
+    // 以view的首部和payload（通常引用view所在的池化缓冲区）构造，不拷贝载荷
+    EthernetFrame(const EthernetView& view, common::ByteStorage payload);
     
     // 创建IPv4以太网帧
     static EthernetFrame createIPv4(const MACAddress& srcMAC, const MACAddress& dstMAC,
@@ -37,12 +89,26 @@ public:
     // 编码为字节数组
     std::vector<uint8_t> encode() const;
     
+    // 将首部编码到out起始的14字节
+    static void encodeHeader(const EthernetHeader& header, uint8_t* out) {
+        fields::EthernetCodec::encode(header, out);
+    }
+    
+    // 以缓冲区现有内容为载荷，在其前部插入以太网首部
+    static void prependHeader(common::PacketBuffer& buf, const MACAddress& srcMAC,
+                              const MACAddress& dstMAC, uint16_t etherType);
+    
     // 从字节数组解码
-    static EthernetFrame decode(const std::vector<uint8_t>& data);
+    static EthernetFrame decode(common::ByteView data);
+    // 不抛出解析异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryDecode(common::ByteView data, EthernetFrame& out);
     
     // 获取有效载荷
     std::vector<uint8_t> getPayload() const;
     
+    // 获取有效载荷视图（不拷贝）
+    common::ByteView payloadView() const { return payload_.view(); }
+    
     // 获取首部信息
     EthernetHeader getHeader() const;
     
@@ -60,7 +126,7 @@ public:
 
 private:
     EthernetHeader header_{};
-    std::vector<uint8_t> payload_;
+    common::ByteStorage payload_;
 };
 
 } // namespace datalink
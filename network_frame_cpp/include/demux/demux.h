@@ -0,0 +1,110 @@
+#ifndef DEMUX_H
+#define DEMUX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include "common/byte_view.h"
+
+namespace demux {
+
+// 分发结果
+enum class Result : uint8_t {
+    Ok,                 // 各层均已识别（或已到达没有下层首部的位置，如IPv4非首片、ARP）
+    UnknownEtherType,   // 以太网类型未注册
+    UnknownProtocol,    // IP协议号未注册
+    Malformed           // 首部长度不足或字段非法
+};
+
+// 逐层识别出的信息（偏移均相对帧起始）
+struct Packet {
+    common::ByteView frame;
+    uint16_t etherType = 0;        // 去掉VLAN标签后的以太网类型
+    uint16_t vlanId = 0;           // 最外层VLAN标识（vlanTags为0时无意义）
+    uint8_t vlanTags = 0;
+    uint8_t ipVersion = 0;         // 4或6，非IP帧为0
+    uint8_t protocol = 0;          // IP协议号（IPv6为跳过扩展首部后的上层协议）
+    bool fragment = false;         // IPv4/IPv6非首片，没有传输层首部
+    uint16_t networkOffset = 0;
+    uint16_t transportOffset = 0;  // 未到达传输层时为0
+    uint16_t srcPort = 0;          // UDP/TCP
+    uint16_t dstPort = 0;
+    uint8_t icmpType = 0;          // ICMP/ICMPv6
+    uint8_t icmpCode = 0;
+
+    common::ByteView network() const { return frame.subview(networkOffset); }
+    common::ByteView transport() const { return frame.subview(transportOffset); }
+};
+
+struct DemuxStats {
+    uint64_t frames = 0;
+    uint64_t arp = 0;
+    uint64_t ipv4 = 0;
+    uint64_t ipv6 = 0;
+    uint64_t vlan = 0;             // 带VLAN标签的帧（每个标签计一次）
+    uint64_t udp = 0;
+    uint64_t tcp = 0;
+    uint64_t icmp = 0;             // 含ICMPv6
+    uint64_t other = 0;            // 只注册了处理函数、没有内置解析的类型
+    uint64_t unknownEtherType = 0;
+    uint64_t unknownProtocol = 0;
+    uint64_t malformed = 0;
+};
+
+// 表驱动的协议分发
+//
+// 以太网类型经65536项的索引表、IP协议号经256项的表在O(1)内找到解析函数，
+// 逐层解析后调用注册的处理函数。未注册的类型只计数，不抛出异常。
+// 内置ARP、IPv4、IPv6、802.1Q/802.1ad VLAN、UDP、TCP、ICMP/ICMPv6的首部识别。
+class Demux {
+public:
+    using Handler = std::function<void(const Packet&)>;
+
+    Demux();
+
+    // 注册以太网类型或IP协议号的处理函数（替换已有处理函数）；
+    // 有内置解析的类型在解析成功后调用，其余类型由此变为已知
+    void onEtherType(uint16_t etherType, Handler handler);
+    void onProtocol(uint8_t protocol, Handler handler);
+
+    // 识别一帧，结果写入packet
+    Result process(common::ByteView frame, Packet& packet);
+
+    const DemuxStats& stats() const { return stats_; }
+    void resetStats() { stats_ = DemuxStats(); }
+
+private:
+    using Decoder = Result (Demux::*)(Packet&);
+
+    struct Entry {
+        Decoder decode = nullptr;
+        uint64_t DemuxStats::* counter = nullptr;
+        Handler handler;
+    };
+
+    std::vector<uint8_t> etherSlots_;       // 以太网类型 -> etherEntries_下标（0表示未注册）
+    std::vector<Entry> etherEntries_;
+    std::vector<Entry> protocolEntries_;    // 按IP协议号索引（counter为空表示未注册）
+    DemuxStats stats_;
+
+    Entry& etherEntry(uint16_t etherType);
+
+    Result dispatchEtherType(Packet& packet, uint16_t etherType, size_t offset);
+    Result dispatchProtocol(Packet& packet);
+
+    Result decodeVlan(Packet& packet);
+    Result decodeArp(Packet& packet);
+    Result decodeIPv4(Packet& packet);
+    Result decodeIPv6(Packet& packet);
+    Result decodePorts(Packet& packet);
+    Result decodeTcp(Packet& packet);
+    Result decodeIcmp(Packet& packet);
+};
+
+// 分发结果名称
+const char* resultName(Result result);
+
+} // namespace demux
+
+#endif // DEMUX_H
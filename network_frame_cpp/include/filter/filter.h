@@ -0,0 +1,74 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include "common/byte_view.h"
+
+namespace filter {
+
+// 过滤程序指令：每条指令对原始帧做一次判断，按结果跳转到jt或jf
+// 跳转只能向后，程序必然终止
+struct Instruction {
+    enum Op : uint8_t {
+        ETHER_TYPE,   // 以太网类型 == value
+        IP_PROTO,     // 上层协议号 == value（IPv4协议字段，IPv6跳过扩展首部）
+        IP_SRC,       // (源IP & mask) == value
+        IP_DST,       // (目的IP & mask) == value
+        SRC_PORT,     // value <= 源端口 <= mask（UDP/TCP，非后续分片）
+        DST_PORT,     // value <= 目的端口 <= mask
+        FRAME_LEN     // 帧长度与value比较（cmp）
+    };
+    enum Cmp : uint8_t { EQ, NE, LT, LE, GT, GE };
+
+    static constexpr uint16_t ACCEPT = 0xFFFF;
+    static constexpr uint16_t REJECT = 0xFFFE;
+
+    Op op;
+    Cmp cmp;
+    uint16_t jt;
+    uint16_t jf;
+    uint32_t value;
+    uint32_t mask;
+};
+
+// 编译后的包过滤器
+//
+// 表达式语法（与tcpdump相近的子集）：
+//   ip | ip6 | arp | vlan | udp | tcp | icmp | proto N
+//   [src|dst] host A.B.C.D    [src|dst] net A.B.C.D/len
+//   [src|dst] port N          [src|dst] portrange N-M
+//   len (<|<=|>|>=|==|!=) N   greater N   less N
+//   not / and / or（也可写作 ! && ||）及括号；udp port 80 等价于 udp and port 80
+// 未指定src/dst时匹配任一方向。空表达式接受所有帧。
+class Filter {
+public:
+    Filter() = default;
+
+    // 编译表达式，语法错误时抛出异常
+    static Filter compile(const std::string& expression);
+
+    // 直接在原始帧上判断，不解码也不分配内存
+    bool matches(common::ByteView frame) const {
+        return program_.empty() || run(frame);
+    }
+
+    bool empty() const { return program_.empty(); }
+    const std::string& expression() const { return expression_; }
+    const std::vector<Instruction>& program() const { return program_; }
+
+    // 输出可读的指令列表
+    std::string dump() const;
+
+private:
+    std::string expression_;
+    std::vector<Instruction> program_;
+
+    bool run(common::ByteView frame) const;
+};
+
+} // namespace filter
+
+#endif // FILTER_H
@@ -0,0 +1,119 @@
+#ifndef FLOW_TABLE_H
+#define FLOW_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <ostream>
+#include "network/ipv4.h"
+#include "transport/udp.h"
+
+namespace flow {
+
+constexpr uint32_t FLOW_EXPORT_MAGIC = 0x4C46464E;   // "NFFL"
+constexpr uint16_t FLOW_EXPORT_VERSION = 1;
+constexpr size_t FLOW_BATCH_HEADER_SIZE = 16;
+constexpr size_t FLOW_RECORD_SIZE = 48;
+
+// 五元组（地址为主机字节序）
+struct FlowKey {
+    uint32_t srcIP = 0;
+    uint32_t dstIP = 0;
+    uint16_t srcPort = 0;
+    uint16_t dstPort = 0;
+    uint8_t protocol = 0;
+
+    static FlowKey fromHeaders(const network::IPv4Header& ipv4, const transport::UDPHeader& udp);
+    static FlowKey fromView(const network::IPv4View& ipv4, const transport::UDPView& udp);
+
+    bool operator==(const FlowKey& other) const {
+        return srcIP == other.srcIP && dstIP == other.dstIP && srcPort == other.srcPort &&
+               dstPort == other.dstPort && protocol == other.protocol;
+    }
+};
+
+// 流记录
+struct FlowRecord {
+    FlowKey key;
+    uint64_t packets = 0;      // 为0表示散列表槽位为空
+    uint64_t bytes = 0;        // IP层字节数
+    uint64_t firstSeenNs = 0;
+    uint64_t lastSeenNs = 0;
+};
+
+struct FlowTableConfig {
+    size_t maxFlows = 65536;                          // 同时跟踪的最大流数
+    uint64_t idleTimeoutNs = 30ULL * 1000000000ULL;   // 超过该时间无报文的流被导出
+};
+
+struct FlowTableStats {
+    uint64_t packets = 0;   // 累加的报文数
+    uint64_t created = 0;   // 新建的流
+    uint64_t expired = 0;   // 因空闲被导出的流
+    uint64_t dropped = 0;   // 表满时未能记录的报文
+};
+
+// 流记录导出器：记录攒成批次后写出
+// 批次首部16字节：magic(4) 版本(2) 记录数(2) 导出时间ns(8)
+// 每条记录48字节：源IP(4) 目的IP(4)（网络字节序）源端口(2) 目的端口(2) 协议(1) 保留(3)
+//                 报文数(8) 字节数(8) 首次(8) 最后(8)
+// 除IP地址外均为小端
+class FlowExporter {
+public:
+    explicit FlowExporter(std::ostream& out, size_t batchSize = 256);
+    ~FlowExporter();
+
+    FlowExporter(const FlowExporter&) = delete;
+    FlowExporter& operator=(const FlowExporter&) = delete;
+
+    void add(const FlowRecord& record, uint64_t nowNs);
+    void flush();
+
+    uint64_t recordsExported() const { return records_; }
+    uint64_t batchesWritten() const { return batches_; }
+
+private:
+    std::ostream& out_;
+    size_t batchSize_;
+    std::vector<uint8_t> buffer_;
+    size_t count_;
+    uint64_t exportNs_;
+    uint64_t records_;
+    uint64_t batches_;
+};
+
+// 流表：开放寻址线性探测，记录直接存放在槽位中，删除采用后移法
+// 所有内存在构造时分配（装载因子不超过1/2）
+class FlowTable {
+public:
+    explicit FlowTable(const FlowTableConfig& config = FlowTableConfig());
+
+    // 累加一个报文，返回所在流记录；表满且为新流时返回nullptr
+    const FlowRecord* update(const FlowKey& key, size_t bytes, uint64_t nowNs);
+
+    const FlowRecord* find(const FlowKey& key) const;
+
+    // 导出并删除空闲超时的流，返回删除数
+    size_t expire(uint64_t nowNs, FlowExporter* exporter);
+
+    // 导出并删除全部流
+    size_t flush(uint64_t nowNs, FlowExporter* exporter);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return config_.maxFlows; }
+    const FlowTableStats& stats() const { return stats_; }
+
+private:
+    FlowTableConfig config_;
+    std::vector<FlowRecord> table_;
+    size_t mask_;
+    size_t size_;
+    FlowTableStats stats_;
+
+    size_t slotFor(const FlowKey& key) const;
+    void erase(size_t index);
+};
+
+} // namespace flow
+
+#endif // FLOW_TABLE_H
@@ -0,0 +1,106 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include "common/frame_batch.h"
+#include "io/frame_io.h"
+#include "sender/sender.h"
+
+namespace generator {
+
+// 流模板数上限（每个流模板保存一份发送配置与首部模板）
+constexpr size_t MAX_FLOWS = 1u << 20;
+
+// 载荷大小分布
+enum class SizeMode {
+    Fixed,    // 固定为minPayload
+    Uniform,  // [minPayload, maxPayload]均匀分布
+    Imix      // 简单IMIX：64/594/1518字节线上帧（含FCS）按7:4:1混合
+};
+
+// 地址/端口区间：start起的count个连续值
+struct AddressRange {
+    network::IPv4Address start{};
+    uint32_t count = 1;
+};
+
+struct PortRange {
+    uint16_t start = 0;
+    uint32_t count = 1;
+};
+
+struct GeneratorConfig {
+    size_t flows = 1;                    // 流模板数，不超过地址/端口组合数与MAX_FLOWS
+    AddressRange srcIP{{{192, 168, 1, 100}}, 1};   // 默认与Sender::defaultConfig一致
+    AddressRange dstIP{{{192, 168, 1, 1}}, 1};
+    PortRange srcPort{12345, 1};
+    PortRange dstPort{80, 1};
+    SizeMode sizeMode = SizeMode::Fixed;
+    size_t minPayload = 18;              // 默认对应64字节最小帧
+    size_t maxPayload = 18;
+    uint64_t packets = 1000000;          // 生成的总报文数
+    size_t batchSize = 256;              // 每批帧数
+    uint64_t seed = 1;
+};
+
+struct GeneratorStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;     // 帧字节数
+    uint64_t elapsedNs = 0;
+
+    double mpps() const {
+        return elapsedNs > 0 ? static_cast<double>(packets) * 1e3 / static_cast<double>(elapsedNs) : 0.0;
+    }
+    double gbps() const {
+        return elapsedNs > 0 ? static_cast<double>(bytes) * 8.0 / static_cast<double>(elapsedNs) : 0.0;
+    }
+};
+
+// 流量生成器
+//
+// 构造时为每个流建立一个首部模板（地址/端口按区间依次组合），
+// 生成时按轮转选取流模板、按分布抽取载荷大小，整批封装到FrameBatch中。
+class Generator {
+public:
+    explicit Generator(const GeneratorConfig& config);
+
+    // 清空batch并生成下一批帧，全部生成完时返回0
+    size_t nextBatch(common::FrameBatch& batch);
+
+    // 生成全部报文并写入out
+    GeneratorStats run(io::FrameWriter& out);
+
+    // 回到起点，重新生成同一序列
+    void reset();
+
+    size_t flowCount() const { return templates_.size(); }
+    const sender::Config& flowConfig(size_t flow) const { return configs_[flow]; }
+    uint64_t generated() const { return generated_; }
+
+private:
+    GeneratorConfig config_;
+    std::vector<sender::Config> configs_;
+    std::vector<sender::HeaderTemplate> templates_;
+    std::vector<uint8_t> payload_;   // 所有帧共用的载荷内容
+    uint64_t generated_;
+    uint64_t rng_;
+    size_t nextFlow_;
+
+    size_t nextPayloadSize();
+};
+
+// 解析载荷大小：N、N-M（均匀分布）或imix
+void parseSizeSpec(const std::string& spec, GeneratorConfig& config);
+
+// 解析A.B.C.D或A.B.C.D-E.F.G.H
+AddressRange parseAddressRange(const std::string& spec);
+
+// 解析N或N-M
+PortRange parsePortRange(const std::string& spec);
+
+} // namespace generator
+
+#endif // GENERATOR_H
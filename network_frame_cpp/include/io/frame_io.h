@@ -0,0 +1,67 @@
+#ifndef FRAME_IO_H
+#define FRAME_IO_H
+
+#include "common/byte_view.h"
+#include "common/frame_batch.h"
+
+namespace io {
+
+// 帧输出后端（pcap文件、套接字、共享内存环等）
+class FrameWriter {
+public:
+    virtual ~FrameWriter() = default;
+
+    // 原地写入：返回可直接写入size字节帧的缓冲区，后端不支持时返回nullptr
+    // 写完后调用commit提交该帧
+    virtual uint8_t* reserve(size_t size) {
+        (void)size;
+        return nullptr;
+    }
+
+    // 提交reserve返回的缓冲区中长度为size的帧
+    virtual void commit(size_t size) {
+        (void)size;
+    }
+
+    // 写入一帧
+    virtual void write(common::ByteView frame) = 0;
+
+    // 写入一批帧，默认逐帧写入
+    virtual void write(const common::FrameBatch& batch) {
+        for (size_t i = 0; i < batch.count(); ++i) {
+            write(batch.frame(i));
+        }
+    }
+
+    // 将缓冲的帧交给底层
+    virtual void flush() {}
+};
+
+// 丢弃所有帧的输出后端（只计数），用于测量发送端本身
+class NullWriter : public FrameWriter {
+public:
+    void write(common::ByteView frame) override {
+        ++frames_;
+        bytes_ += frame.size();
+    }
+
+    uint64_t frames() const { return frames_; }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    uint64_t frames_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+// 帧输入后端：返回的帧至少在下一次调用next前有效
+class FrameReader {
+public:
+    virtual ~FrameReader() = default;
+
+    // 读取下一帧，输入结束时返回false
+    virtual bool next(common::ByteView& frame) = 0;
+};
+
+} // namespace io
+
+#endif // FRAME_IO_H
@@ -0,0 +1,103 @@
+#ifndef PCAP_H
+#define PCAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "common/byte_view.h"
+#include "common/frame_batch.h"
+#include "io/frame_io.h"
+
+namespace io {
+
+constexpr uint32_t PCAP_MAGIC_MICRO = 0xA1B2C3D4;
+constexpr uint32_t PCAP_MAGIC_NANO = 0xA1B23C4D;
+constexpr uint32_t PCAP_LINKTYPE_ETHERNET = 1;
+constexpr uint32_t PCAP_SNAPLEN = 262144;
+constexpr size_t PCAP_GLOBAL_HEADER_SIZE = 24;
+constexpr size_t PCAP_RECORD_HEADER_SIZE = 16;
+constexpr size_t PCAP_WRITE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+// 判断文件名是否为pcap格式（按扩展名）
+bool isPcapFile(const std::string& filename);
+
+// pcap记录（数据指向映射的文件内容，不拷贝）
+struct PcapRecord {
+    uint64_t timestampNs;
+    uint32_t originalLength;
+    common::ByteView data;
+};
+
+// pcap写入器：记录先写入用户态缓冲区，攒满后整块写出
+class PcapWriter : public FrameWriter {
+public:
+    explicit PcapWriter(const std::string& filename,
+                        size_t bufferSize = PCAP_WRITE_BUFFER_SIZE);
+    ~PcapWriter() override;
+
+    PcapWriter(const PcapWriter&) = delete;
+    PcapWriter& operator=(const PcapWriter&) = delete;
+
+    // 写入一帧（使用当前时间作为时间戳）
+    void write(common::ByteView frame) override;
+
+    // 写入一帧（指定纳秒时间戳）
+    void write(common::ByteView frame, uint64_t timestampNs);
+
+    // 写入一批帧（共用同一时间戳）
+    void write(const common::FrameBatch& batch) override;
+    
+    // 将缓冲区内容写入文件
+    void flush() override;
+
+    // 刷新并关闭文件
+    void close();
+
+    uint64_t framesWritten() const { return frames_; }
+
+private:
+    int fd_;
+    std::string filename_;
+    std::vector<uint8_t> buffer_;
+    size_t used_;
+    uint64_t frames_;
+
+    void writeAll(const uint8_t* data, size_t len);
+};
+
+// pcap读取器：整个文件mmap映射，按记录顺序迭代
+class PcapReader : public FrameReader {
+public:
+    explicit PcapReader(const std::string& filename);
+    ~PcapReader() override;
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    // 读取下一条记录，文件结束时返回false，记录被截断时抛出异常
+    bool next(PcapRecord& record);
+
+    // 只取帧数据
+    bool next(common::ByteView& frame) override;
+
+    // 回到第一条记录
+    void rewind() { offset_ = PCAP_GLOBAL_HEADER_SIZE; }
+
+    uint32_t linkType() const { return linkType_; }
+
+private:
+    const uint8_t* map_;
+    size_t size_;
+    size_t offset_;
+    bool swapped_;
+    bool nanosecond_;
+    uint32_t linkType_;
+
+    uint32_t readU32(size_t offset) const;
+};
+
+} // namespace io
+
+#endif // PCAP_H
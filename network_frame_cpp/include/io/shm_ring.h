@@ -0,0 +1,114 @@
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "common/byte_view.h"
+#include "io/frame_io.h"
+
+namespace io {
+
+constexpr size_t SHM_DEFAULT_SLOTS = 4096;
+constexpr size_t SHM_DEFAULT_SLOT_SIZE = 2048;
+constexpr size_t SHM_SLOT_HEADER_SIZE = 16;   // 每个槽位前部存放帧长度
+
+// 共享内存环配置：固定大小槽位组成的单生产者单消费者环，由接收端创建
+struct ShmRingConfig {
+    std::string name = "/network_frame";
+    size_t slots = SHM_DEFAULT_SLOTS;         // 槽位数（向上取整为2的幂）
+    size_t slotSize = SHM_DEFAULT_SLOT_SIZE;  // 槽位字节数（含槽位首部）
+};
+
+// 判断名称是否为共享内存环地址（shm://name）
+bool isShmAddress(const std::string& name);
+
+// 解析shm://name，其余字段沿用base
+ShmRingConfig parseShmAddress(const std::string& name, const ShmRingConfig& base = ShmRingConfig());
+
+struct ShmRingHeader;
+
+// 共享内存环映射（读写两端共用）
+class ShmRing {
+public:
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    size_t slots() const;
+    size_t slotSize() const;
+
+    // 单个槽位可容纳的最大帧长
+    size_t maxFrameSize() const { return slotSize() - SHM_SLOT_HEADER_SIZE; }
+
+protected:
+    ShmRing(const ShmRingConfig& config, bool create);
+    ~ShmRing();
+
+    ShmRingHeader* ring_;
+    uint8_t* slotData_;
+    size_t mapSize_;
+    size_t mask_;
+    std::string name_;
+    bool owner_;
+
+    uint8_t* slot(uint64_t index) const { return slotData_ + (index & mask_) * slotSize(); }
+
+    // 自适应自旋：等待期间用完自旋预算后在futex上休眠
+    // 自旋内等到时加倍预算，休眠后减半
+    uint32_t spinLimit_;
+    void spinSucceeded();
+    void spinFailed();
+};
+
+// 生产者端：Sender可直接把帧封装进槽位
+class ShmRingWriter : public FrameWriter, public ShmRing {
+public:
+    // 连接到接收端已创建的环
+    explicit ShmRingWriter(const ShmRingConfig& config);
+    ~ShmRingWriter() override;
+
+    // 等待空闲槽位并返回其帧缓冲区
+    uint8_t* reserve(size_t size) override;
+    void commit(size_t size) override;
+
+    // 拷贝一帧到下一个槽位
+    void write(common::ByteView frame) override;
+
+    // 标记输入结束并唤醒接收端
+    void close();
+
+    uint64_t framesWritten() const { return frames_; }
+    uint64_t sleeps() const { return sleeps_; }
+
+private:
+    uint64_t tail_;         // 本端写入位置
+    uint64_t cachedHead_;   // 缓存的消费者位置
+    uint64_t frames_;
+    uint64_t sleeps_;
+    bool closed_;
+};
+
+// 消费者端：返回的帧直接指向槽位，在下一次调用next时释放
+class ShmRingReader : public FrameReader, public ShmRing {
+public:
+    // 创建（或重新初始化）共享内存环，析构时删除
+    explicit ShmRingReader(const ShmRingConfig& config);
+    ~ShmRingReader() override;
+
+    // 读取下一帧；生产者关闭且环为空时返回false
+    bool next(common::ByteView& frame) override;
+
+    uint64_t framesRead() const { return frames_; }
+    uint64_t sleeps() const { return sleeps_; }
+
+private:
+    uint64_t head_;         // 本端读取位置
+    uint64_t cachedTail_;   // 缓存的生产者位置
+    bool holding_;          // 是否持有上一次返回的槽位
+    uint64_t frames_;
+    uint64_t sleeps_;
+};
+
+} // namespace io
+
+#endif // SHM_RING_H
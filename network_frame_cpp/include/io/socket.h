@@ -0,0 +1,108 @@
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "common/byte_view.h"
+#include "common/frame_batch.h"
+#include "io/frame_io.h"
+
+namespace io {
+
+constexpr uint16_t SOCKET_DEFAULT_PORT = 9000;
+constexpr size_t SOCKET_DEFAULT_BATCH = 32;
+constexpr size_t SOCKET_MAX_FRAME_SIZE = 65507;   // 单个UDP数据报可承载的最大帧长
+constexpr int SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;
+
+// 回环套接字配置：每个以太网帧作为一个UDP数据报在本机传输
+struct SocketConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = SOCKET_DEFAULT_PORT;
+    size_t batchSize = SOCKET_DEFAULT_BATCH;  // 每次sendmmsg/recvmmsg的帧数
+    bool busyPoll = false;                    // 接收端忙轮询而不阻塞等待
+    int idleTimeoutMs = 1000;                 // 收到首帧后空闲超过该时间视为输入结束
+};
+
+// 判断名称是否为套接字地址（udp://host:port）
+bool isSocketAddress(const std::string& name);
+
+// 解析udp://host:port，未指定的字段沿用base
+SocketConfig parseSocketAddress(const std::string& name, const SocketConfig& base = SocketConfig());
+
+// 套接字发送端：帧攒满一批后用一次sendmmsg发出
+class SocketWriter : public FrameWriter {
+public:
+    explicit SocketWriter(const SocketConfig& config);
+    ~SocketWriter() override;
+
+    SocketWriter(const SocketWriter&) = delete;
+    SocketWriter& operator=(const SocketWriter&) = delete;
+
+    // 写入一帧（拷贝到发送缓冲区）
+    void write(common::ByteView frame) override;
+
+    // 写入一批帧（直接引用批内存，不拷贝）
+    void write(const common::FrameBatch& batch) override;
+
+    // 发出缓冲区中的帧
+    void flush() override;
+
+    uint64_t framesSent() const { return frames_; }
+    uint64_t syscalls() const { return syscalls_; }
+
+private:
+    int fd_;
+    SocketConfig config_;
+    sockaddr_in address_;
+    common::FrameBatch staged_;   // write(ByteView)攒下的帧
+    std::vector<iovec> iov_;
+    std::vector<mmsghdr> messages_;
+    uint64_t frames_;
+    uint64_t syscalls_;
+
+    // 发送iov_中的前count帧
+    void send(size_t count);
+
+    // 逐批发送batch中的帧
+    void sendBatch(const common::FrameBatch& batch);
+};
+
+// 套接字接收端：一次recvmmsg收取一批帧，逐帧返回
+class SocketReader : public FrameReader {
+public:
+    explicit SocketReader(const SocketConfig& config);
+    ~SocketReader() override;
+
+    SocketReader(const SocketReader&) = delete;
+    SocketReader& operator=(const SocketReader&) = delete;
+
+    // 读取下一帧；首帧前一直等待，之后空闲超时返回false
+    bool next(common::ByteView& frame) override;
+
+    uint64_t framesReceived() const { return frames_; }
+    uint64_t truncated() const { return truncated_; }
+    uint64_t syscalls() const { return syscalls_; }
+
+private:
+    int fd_;
+    SocketConfig config_;
+    std::vector<uint8_t> buffer_;
+    std::vector<iovec> iov_;
+    std::vector<mmsghdr> messages_;
+    size_t count_;
+    size_t index_;
+    uint64_t frames_;
+    uint64_t truncated_;
+    uint64_t syscalls_;
+
+    // 收取下一批帧，超时返回false
+    bool receive();
+};
+
+} // namespace io
+
+#endif // SOCKET_H
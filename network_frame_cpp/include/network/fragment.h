@@ -0,0 +1,136 @@
+#ifndef FRAGMENT_H
+#define FRAGMENT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <atomic>
+#include "common/byte_view.h"
+#include "network/ipv4.h"
+
+namespace network {
+
+constexpr uint8_t IPV4_FLAG_DF = 0x2;  // 不分片
+constexpr uint8_t IPV4_FLAG_MF = 0x1;  // 还有后续分片
+constexpr uint16_t DEFAULT_MTU = 1500;
+constexpr size_t IPV4_MAX_HEADER_SIZE = 60;
+constexpr size_t IPV4_MAX_PACKET_SIZE = 0xFFFF;
+
+// 判断数据报是否为分片
+inline bool isFragment(const IPv4View& packet) {
+    return (packet.flags() & IPV4_FLAG_MF) != 0 || packet.fragmentOffset() != 0;
+}
+
+// IP标识生成器：按(源, 目的, 协议)散列到若干独立计数器，每条流的标识各自递增
+class IdGenerator {
+public:
+    IdGenerator();
+
+    uint16_t next(const IPv4Address& srcIP, const IPv4Address& dstIP, uint8_t protocol);
+
+    // 进程内共享的生成器
+    static IdGenerator& global();
+
+private:
+    static constexpr size_t BUCKETS = 2048;
+
+    std::array<std::atomic<uint16_t>, BUCKETS> counters_;
+    uint32_t seed_;
+};
+
+// 重组配置（内存上限为 maxDatagrams * (IPV4_MAX_HEADER_SIZE + maxDatagramSize)）
+struct ReassemblyConfig {
+    size_t maxDatagrams = 64;              // 同时重组的数据报数
+    size_t maxDatagramSize = 65535 - 20;   // 单个数据报载荷上限
+    uint64_t timeoutNs = 30000000000ULL;   // 从第一个分片到达起的超时时间
+};
+
+// 重组统计
+struct ReassemblyStats {
+    uint64_t fragments = 0;   // 收到的分片数
+    uint64_t completed = 0;   // 重组完成的数据报数
+    uint64_t timedOut = 0;    // 超时丢弃的数据报数
+    uint64_t evicted = 0;     // 槽位耗尽时被挤出的数据报数
+    uint64_t invalid = 0;     // 长度或偏移非法的分片数
+    uint64_t tooManyHoles = 0;// 空洞过多而丢弃的数据报数
+};
+
+// IPv4分片重组器
+//
+// 所有内存在构造时一次性分配：固定数量的槽位、每个槽位一块数据报缓冲区、
+// 开放寻址散列表以及按到达顺序串起的链表（用于O(1)超时和淘汰）。
+// 每个槽位用RFC 815的空洞描述符表记录尚未收到的区间。
+class Reassembler {
+public:
+    explicit Reassembler(const ReassemblyConfig& config = ReassemblyConfig());
+
+    // 处理一个分片；数据报重组完成时返回true，datagram指向完整的IPv4数据报
+    // （首部已清除分片字段并重算校验和），在下一次调用add前有效
+    bool add(const IPv4View& fragment, uint64_t nowNs, common::ByteView& datagram);
+
+    // 丢弃超时的数据报
+    void expire(uint64_t nowNs);
+
+    size_t pending() const { return used_; }
+    const ReassemblyStats& stats() const { return stats_; }
+
+private:
+    static constexpr size_t MAX_HOLES = 16;
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    static constexpr uint32_t INFINITE_OFFSET = 0xFFFFFFFF;
+
+    struct Key {
+        IPv4Address srcIP;
+        IPv4Address dstIP;
+        uint16_t identification;
+        uint8_t protocol;
+
+        bool operator==(const Key& other) const {
+            return srcIP == other.srcIP && dstIP == other.dstIP &&
+                   identification == other.identification && protocol == other.protocol;
+        }
+    };
+
+    // 空洞：[first, last]闭区间（字节偏移）
+    struct Hole {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    struct Slot {
+        Key key;
+        uint64_t firstSeenNs;
+        uint32_t prev;            // 到达顺序链表
+        uint32_t next;
+        uint32_t tableIndex;      // 在散列表中的位置
+        uint32_t totalLength;     // 载荷总长度（收到最后一个分片前未知）
+        uint32_t headerLength;    // 首部长度（取自偏移为0的分片）
+        uint8_t holeCount;
+        std::array<Hole, MAX_HOLES> holes;
+    };
+
+    ReassemblyConfig config_;
+    size_t slotBytes_;
+    std::vector<uint8_t> buffers_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> table_;
+    size_t tableMask_;
+    uint32_t oldest_;
+    uint32_t newest_;
+    size_t used_;
+    ReassemblyStats stats_;
+
+    uint8_t* slotBuffer(uint32_t slot) { return buffers_.data() + slot * slotBytes_; }
+    size_t hashKey(const Key& key) const;
+    uint32_t find(const Key& key) const;
+    uint32_t allocate(const Key& key, uint64_t nowNs);
+    void release(uint32_t slot);
+    void tableErase(uint32_t index);
+    bool fillHole(Slot& slot, uint32_t first, uint32_t last, bool moreFragments);
+};
+
+} // namespace network
+
+#endif // FRAGMENT_H
@@ -6,11 +6,19 @@
 #include <string>
 #include <array>
 #include <stdexcept>
+#include "common/byte_view.h"
+#include "common/packet_buffer.h"
+#include "common/byte_storage.h"
+#include "common/header_fields.h"
+#include "common/decode_status.h"
 
 namespace network {
 
 constexpr size_t IPV4_HEADER_SIZE = 20;
+constexpr uint8_t PROTOCOL_ICMP = 1;
+constexpr uint8_t PROTOCOL_TCP = 6;
 constexpr uint8_t PROTOCOL_UDP = 17;
+constexpr uint8_t PROTOCOL_ICMPV6 = 58;
 constexpr uint8_t DEFAULT_TTL = 64;
 
 // IPv4地址类型
@@ -32,12 +40,84 @@ struct IPv4Header {
     IPv4Address dstIP;
 };
 
+// IPv4首部（不含选项）字段布局
+namespace fields {
+using Version = common::BitField<0, 4>;
+using Ihl = common::BitField<4, 4>;
+using Tos = common::BitField<8, 8>;
+using TotalLength = common::BitField<16, 16>;
+using Identification = common::BitField<32, 16>;
+using Flags = common::BitField<48, 3>;
+using FragmentOffset = common::BitField<51, 13>;
+using Ttl = common::BitField<64, 8>;
+using Protocol = common::BitField<72, 8>;
+using HeaderChecksum = common::BitField<80, 16>;
+using SrcIP = common::ByteField<12, 4>;
+using DstIP = common::ByteField<16, 4>;
+
+using IPv4Codec = common::HeaderCodec<IPv4Header, IPV4_HEADER_SIZE,
+    common::Bind<&IPv4Header::version, Version>,
+    common::Bind<&IPv4Header::ihl, Ihl>,
+    common::Bind<&IPv4Header::tos, Tos>,
+    common::Bind<&IPv4Header::totalLength, TotalLength>,
+    common::Bind<&IPv4Header::identification, Identification>,
+    common::Bind<&IPv4Header::flags, Flags>,
+    common::Bind<&IPv4Header::fragmentOffset, FragmentOffset>,
+    common::Bind<&IPv4Header::ttl, Ttl>,
+    common::Bind<&IPv4Header::protocol, Protocol>,
+    common::Bind<&IPv4Header::headerChecksum, HeaderChecksum>,
+    common::Bind<&IPv4Header::srcIP, SrcIP>,
+    common::Bind<&IPv4Header::dstIP, DstIP>>;
+} // namespace fields
+
+// IPv4数据报只读视图（原地解析首部，载荷指向原缓冲区）
+class IPv4View {
+public:
+    IPv4View() = default;
+
+    // 解析IPv4数据报，首部非法时抛出异常
+    static IPv4View parse(common::ByteView data);
+    // 不抛出异常的版本：成功时写入out并返回Ok（不校验首部校验和）
+    static common::DecodeStatus tryParse(common::ByteView data, IPv4View& out) noexcept;
+
+    uint8_t version() const { return fields::Version::get(data_.data()); }
+    uint8_t ihl() const { return fields::Ihl::get(data_.data()); }
+    size_t headerLength() const { return static_cast<size_t>(ihl()) * 4; }
+    uint8_t tos() const { return fields::Tos::get(data_.data()); }
+    uint16_t totalLength() const { return fields::TotalLength::get(data_.data()); }
+    uint16_t identification() const { return fields::Identification::get(data_.data()); }
+    uint8_t flags() const { return fields::Flags::get(data_.data()); }
+    uint16_t fragmentOffset() const { return fields::FragmentOffset::get(data_.data()); }
+    uint8_t ttl() const { return fields::Ttl::get(data_.data()); }
+    uint8_t protocol() const { return fields::Protocol::get(data_.data()); }
+    uint16_t headerChecksum() const { return fields::HeaderChecksum::get(data_.data()); }
+    IPv4Address srcIP() const { return fields::SrcIP::get(data_.data()); }
+    IPv4Address dstIP() const { return fields::DstIP::get(data_.data()); }
+    IPv4Header header() const { return fields::IPv4Codec::decode(data_.data()); }
+    bool isUDP() const { return protocol() == PROTOCOL_UDP; }
+
+    // 校验首部校验和
+    bool checksumValid() const;
+
+    // 整个数据报（按总长度截断）与有效载荷
+    common::ByteView bytes() const { return data_; }
+    common::ByteView payload() const { return data_.subview(headerLength()); }
+
+private:
+    explicit IPv4View(common::ByteView data) : data_(data) {}
+
+    common::ByteView data_;
+};
+
 // IPv4数据报类
 class IPv4Packet {
 public:
     IPv4Packet() = default;
     IPv4Packet(const IPv4Address& srcIP, const IPv4Address& dstIP, 
                uint8_t protocol, const std::vector<uint8_t>& payload);
+    explicit IPv4Packet(const IPv4View& view);
+    // 以view的首部和payload（通常引用view所在的池化缓冲区）构造，不拷贝载荷
+    IPv4Packet(const IPv4View& view, common::ByteStorage payload);
     
     // 创建UDP数据报
     static IPv4Packet createUDP(const IPv4Address& srcIP, const IPv4Address& dstIP,
@@ -46,12 +126,24 @@ public:
     // 编码为字节数组
     std::vector<uint8_t> encode() const;
     
+    // 将首部编码到out起始的20字节（自动计算首部校验和）
+    static void encodeHeader(const IPv4Header& header, uint8_t* out);
+    
+    // 以缓冲区现有内容为载荷，在其前部插入IPv4首部
+    static void prependHeader(common::PacketBuffer& buf, const IPv4Address& srcIP,
+                              const IPv4Address& dstIP, uint8_t protocol);
+    
     // 从字节数组解码
-    static IPv4Packet decode(const std::vector<uint8_t>& data);
+    static IPv4Packet decode(common::ByteView data);
+    // 不抛出解析异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryDecode(common::ByteView data, IPv4Packet& out);
     
     // 获取有效载荷
     std::vector<uint8_t> getPayload() const;
     
+    // 获取有效载荷视图（不拷贝）
+    common::ByteView payloadView() const { return payload_.view(); }
+    
     // 获取首部信息
     IPv4Header getHeader() const;
     
@@ -69,10 +161,7 @@ public:
 
 private:
     IPv4Header header_{};
-    std::vector<uint8_t> payload_;
-    
-    // 计算首部校验和
-    static uint16_t calculateChecksum(const std::vector<uint8_t>& header);
+    common::ByteStorage payload_;
 };
 
 } // namespace network
@@ -0,0 +1,177 @@
+#ifndef IPV6_H
+#define IPV6_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <array>
+#include <stdexcept>
+#include "common/byte_view.h"
+#include "common/packet_buffer.h"
+#include "common/byte_storage.h"
+#include "common/header_fields.h"
+#include "common/decode_status.h"
+#include "network/ipv4.h"
+
+namespace network {
+
+constexpr size_t IPV6_HEADER_SIZE = 40;
+constexpr uint8_t DEFAULT_HOP_LIMIT = 64;
+
+// 扩展首部类型（下一首部字段取值）
+constexpr uint8_t IPV6_EXT_HOP_BY_HOP = 0;
+constexpr uint8_t IPV6_EXT_ROUTING = 43;
+constexpr uint8_t IPV6_EXT_FRAGMENT = 44;
+constexpr uint8_t IPV6_EXT_AH = 51;
+constexpr uint8_t IPV6_EXT_DEST_OPTIONS = 60;
+constexpr uint8_t IPV6_NO_NEXT_HEADER = 59;
+constexpr size_t IPV6_FRAGMENT_HEADER_SIZE = 8;
+
+// 扩展首部遍历上限：按RFC 8200的推荐顺序每种至多出现一次（目的选项两次），
+// 超过上限的报文视为畸形，避免被构造的长链拖慢解析
+constexpr size_t IPV6_MAX_EXTENSION_HEADERS = 8;
+
+// IPv6地址类型
+using IPv6Address = std::array<uint8_t, 16>;
+
+// IPv6首部结构
+struct IPv6Header {
+    uint8_t version;
+    uint8_t trafficClass;
+    uint32_t flowLabel;
+    uint16_t payloadLength;  // 首部之后（含扩展首部）的长度
+    uint8_t nextHeader;
+    uint8_t hopLimit;
+    IPv6Address srcIP;
+    IPv6Address dstIP;
+};
+
+// IPv6固定首部字段布局（版本号与IPv4共用fields::Version）
+namespace fields {
+using TrafficClass = common::BitField<4, 8>;
+using FlowLabel = common::BitField<12, 20>;
+using PayloadLength = common::BitField<32, 16>;
+using NextHeader = common::BitField<48, 8>;
+using HopLimit = common::BitField<56, 8>;
+using SrcIPv6 = common::ByteField<8, 16>;
+using DstIPv6 = common::ByteField<24, 16>;
+
+using IPv6Codec = common::HeaderCodec<IPv6Header, IPV6_HEADER_SIZE,
+    common::Bind<&IPv6Header::version, Version>,
+    common::Bind<&IPv6Header::trafficClass, TrafficClass>,
+    common::Bind<&IPv6Header::flowLabel, FlowLabel>,
+    common::Bind<&IPv6Header::payloadLength, PayloadLength>,
+    common::Bind<&IPv6Header::nextHeader, NextHeader>,
+    common::Bind<&IPv6Header::hopLimit, HopLimit>,
+    common::Bind<&IPv6Header::srcIP, SrcIPv6>,
+    common::Bind<&IPv6Header::dstIP, DstIPv6>>;
+} // namespace fields
+
+// 扩展首部遍历结果
+struct IPv6Extensions {
+    uint8_t protocol = IPV6_NO_NEXT_HEADER;  // 上层协议号
+    uint8_t count = 0;                       // 经过的扩展首部数
+    uint32_t offset = IPV6_HEADER_SIZE;      // 上层首部相对IPv6首部的偏移
+    bool fragment = false;                   // 含分片首部
+    bool moreFragments = false;
+    uint16_t fragmentOffset = 0;             // 以8字节为单位
+    uint32_t identification = 0;
+};
+
+// IPv6数据报只读视图（原地解析首部，载荷指向原缓冲区）
+class IPv6View {
+public:
+    IPv6View() = default;
+
+    // 解析IPv6数据报，首部非法时抛出异常
+    static IPv6View parse(common::ByteView data);
+    // 不抛出异常的版本：成功时写入out并返回Ok（不遍历扩展首部）
+    static common::DecodeStatus tryParse(common::ByteView data, IPv6View& out) noexcept;
+
+    uint8_t version() const { return fields::Version::get(data_.data()); }
+    uint8_t trafficClass() const { return fields::TrafficClass::get(data_.data()); }
+    uint32_t flowLabel() const { return fields::FlowLabel::get(data_.data()); }
+    uint16_t payloadLength() const { return fields::PayloadLength::get(data_.data()); }
+    uint8_t nextHeader() const { return fields::NextHeader::get(data_.data()); }
+    uint8_t hopLimit() const { return fields::HopLimit::get(data_.data()); }
+    IPv6Address srcIP() const { return fields::SrcIPv6::get(data_.data()); }
+    IPv6Address dstIP() const { return fields::DstIPv6::get(data_.data()); }
+    IPv6Header header() const { return fields::IPv6Codec::decode(data_.data()); }
+
+    // 沿下一首部链跳过扩展首部找到上层首部：至多IPV6_MAX_EXTENSION_HEADERS个，
+    // 只读取各扩展首部的前几个字节，不分配内存
+    common::DecodeStatus walkExtensions(IPv6Extensions& out) const noexcept;
+
+    // 整个数据报（按载荷长度截断）、固定首部之后的部分，以及上层首部起始的部分
+    common::ByteView bytes() const { return data_; }
+    common::ByteView payload() const { return data_.subview(IPV6_HEADER_SIZE); }
+    common::ByteView upperLayer(const IPv6Extensions& extensions) const {
+        return data_.subview(extensions.offset);
+    }
+
+private:
+    explicit IPv6View(common::ByteView data) : data_(data) {}
+
+    common::ByteView data_;
+};
+
+// IPv6数据报类（不含扩展首部）
+class IPv6Packet {
+public:
+    IPv6Packet() = default;
+    IPv6Packet(const IPv6Address& srcIP, const IPv6Address& dstIP,
+               uint8_t nextHeader, const std::vector<uint8_t>& payload);
+    explicit IPv6Packet(const IPv6View& view);
+    // 以view的首部和payload（通常引用view所在的池化缓冲区）构造，不拷贝载荷
+    IPv6Packet(const IPv6View& view, common::ByteStorage payload);
+
+    // 创建UDP数据报
+    static IPv6Packet createUDP(const IPv6Address& srcIP, const IPv6Address& dstIP,
+                                const std::vector<uint8_t>& payload);
+
+    // 编码为字节数组
+    std::vector<uint8_t> encode() const;
+
+    // 将首部编码到out起始的40字节
+    static void encodeHeader(const IPv6Header& header, uint8_t* out) {
+        fields::IPv6Codec::encode(header, out);
+    }
+
+    // 以缓冲区现有内容为载荷，在其前部插入IPv6首部
+    static void prependHeader(common::PacketBuffer& buf, const IPv6Address& srcIP,
+                              const IPv6Address& dstIP, uint8_t nextHeader);
+
+    // 从字节数组解码（扩展首部作为载荷的一部分保留）
+    static IPv6Packet decode(common::ByteView data);
+    // 不抛出解析异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryDecode(common::ByteView data, IPv6Packet& out);
+
+    // 获取有效载荷
+    std::vector<uint8_t> getPayload() const;
+
+    // 获取首部信息
+    IPv6Header getHeader() const;
+
+    // 下一首部是否为UDP
+    bool isUDP() const;
+
+    // 地址转换为RFC 5952文本形式（小写、最长的连续零组压缩为"::"，
+    // IPv4映射地址以点分十进制结尾）
+    static std::string addressToString(const IPv6Address& ip);
+
+    // 解析文本形式的地址（支持"::"与结尾的点分十进制IPv4），格式错误时抛出异常
+    static IPv6Address parseAddress(const std::string& text);
+    // 不抛出异常的版本：格式错误时返回false
+    static bool tryParseAddress(const char* text, size_t len, IPv6Address& out) noexcept;
+
+    // 字符串表示
+    std::string toString() const;
+
+private:
+    IPv6Header header_{};
+    common::ByteStorage payload_;
+};
+
+} // namespace network
+
+#endif // IPV6_H
@@ -0,0 +1,87 @@
+#ifndef PARSED_PACKET_H
+#define PARSED_PACKET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include "application/application.h"
+#include "common/byte_storage.h"
+#include "transport/udp.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "datalink/ethernet.h"
+
+namespace receiver {
+
+// 解析后的数据包（按需解析）
+//
+// Receiver::decapsulate只解析并校验以太网与IP首部（分片重组需要），
+// UDP首部及其校验和在首次访问传输层或应用层时才解析，各层对象也在首次访问时
+// 才构造，并内联缓存在本对象中。持有整个帧（重组后的数据报接在以太网首部之后），
+// 视图指向自身存储，因此只能移动不能拷贝。
+class ParsedPacket {
+public:
+    ParsedPacket() = default;
+    ParsedPacket(ParsedPacket&&) = default;
+    ParsedPacket& operator=(ParsedPacket&&) = default;
+    ParsedPacket(const ParsedPacket&) = delete;
+    ParsedPacket& operator=(const ParsedPacket&) = delete;
+
+    // 整个帧
+    common::ByteView frame() const { return storage_.view(); }
+
+    // 各层首部在帧中的偏移（不触发解析；IPv6的传输层偏移已跳过扩展首部）
+    size_t networkOffset() const { return datalink::ETHERNET_HEADER_SIZE; }
+    size_t transportOffset() const { return static_cast<size_t>(transport_.data() - frame().data()); }
+    size_t payloadOffset() const { return transportOffset() + transport::UDP_HEADER_SIZE; }
+
+    // IP版本（4或6），决定ipv4()与ipv6()中哪个有效
+    uint8_t ipVersion() const { return ipVersion_; }
+    bool isIPv6() const { return ipVersion_ == 6; }
+    // 上层协议号
+    uint8_t protocol() const { return protocol_; }
+
+    // 零拷贝视图：以太网与IP首部已校验；udp()首次调用时解析并校验UDP，失败时抛出异常
+    const datalink::EthernetView& ethernet() const { return ethernet_; }
+    const network::IPv4View& ipv4() const { return ipv4_; }
+    const network::IPv6View& ipv6() const { return ipv6_; }
+    const transport::UDPView& udp();
+    common::ByteView payload() { return udp().payload(); }
+    bool transportParsed() const { return udp_.has_value(); }
+
+    // 各层对象，首次访问时构造（池化帧的载荷直接引用缓冲区，否则拷贝）
+    datalink::EthernetFrame& ethernetFrame();
+    network::IPv4Packet& ipv4Packet();    // 不是IPv4时抛出异常
+    network::IPv6Packet& ipv6Packet();    // 不是IPv6时抛出异常
+    transport::UDPDatagram& udpDatagram();
+    application::Data& applicationData();
+
+private:
+    friend class Receiver;
+
+    // storage中的帧首部已由Receiver校验
+    ParsedPacket(common::ByteStorage storage, bool verifyChecksums);
+
+    common::ByteStorage storage_;
+    bool verifyChecksums_ = true;
+    datalink::EthernetView ethernet_;
+    network::IPv4View ipv4_;
+    network::IPv6View ipv6_;
+    common::ByteView transport_;  // 上层首部起始的数据
+    uint8_t ipVersion_ = 4;
+    uint8_t protocol_ = 0;
+    std::optional<transport::UDPView> udp_;
+    std::optional<datalink::EthernetFrame> ethernetFrame_;
+    std::optional<network::IPv4Packet> ipv4Packet_;
+    std::optional<network::IPv6Packet> ipv6Packet_;
+    std::optional<transport::UDPDatagram> udpDatagram_;
+    std::optional<application::Data> applicationData_;
+
+    common::ByteStorage slice(common::ByteView part) const {
+        return storage_.slice(static_cast<size_t>(part.data() - storage_.view().data()), part.size());
+    }
+};
+
+} // namespace receiver
+
+#endif // PARSED_PACKET_H
@@ -0,0 +1,109 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include "common/byte_view.h"
+#include "common/spsc_ring.h"
+#include "common/toeplitz.h"
+#include "receiver/receiver.h"
+
+namespace receiver {
+
+// 多核接收流水线配置
+struct PipelineConfig {
+    size_t workers = 4;        // 工作线程数
+    size_t ringSize = 4096;    // 每个工作线程的队列长度
+    bool pinCores = false;     // 是否将工作线程绑定到CPU核
+    size_t firstCore = 1;      // 第一个工作线程绑定的核（0号核留给分发线程）
+    Options receiver;          // 各工作线程Receiver的选项
+};
+
+// 单个工作线程的统计
+struct WorkerStats {
+    uint64_t packets = 0;        // 解封装成功的数据报数
+    uint64_t bytes = 0;          // 处理的帧字节数
+    uint64_t errors = 0;         // 解封装失败的帧数
+    uint64_t filtered = 0;       // 被过滤器丢弃的帧数
+    uint64_t skipped = 0;        // 不是IP/UDP而被跳过的帧数
+    uint64_t fragments = 0;      // 等待重组的分片数
+    uint64_t activeNs = 0;       // 第一帧到最后一帧的时间跨度
+    common::DropCounters drops;  // 解封装失败的原因明细
+
+    // 包速率（百万包/秒）
+    double mpps() const {
+        return activeNs > 0 ? static_cast<double>(packets) * 1e3 / static_cast<double>(activeNs) : 0.0;
+    }
+};
+
+// 多核接收流水线
+//
+// 调用dispatch的线程作为分发线程：按Toeplitz散列把每帧的五元组映射到某个
+// 工作线程，经SPSC队列交给该线程解封装，同一条流始终由同一线程按序处理。
+// IPv4分片只按地址对散列，保证同一数据报的分片落在同一线程上重组。
+class ReceivePipeline {
+public:
+    // 每个成功解封装的数据报在其工作线程中调用一次（需线程安全）
+    using Handler = std::function<void(size_t worker, const PacketView&)>;
+
+    ReceivePipeline(const PipelineConfig& config, Handler handler);
+    ~ReceivePipeline();
+
+    ReceivePipeline(const ReceivePipeline&) = delete;
+    ReceivePipeline& operator=(const ReceivePipeline&) = delete;
+
+    void start();
+
+    // 分发一帧；帧数据须在stop返回前保持有效（零拷贝）。队列满时自旋等待
+    void dispatch(common::ByteView frame);
+
+    // 等待已分发的帧全部处理完毕（之后可复用这些帧的内存）
+    void wait();
+
+    // 等待所有队列处理完毕并结束工作线程
+    void stop();
+
+    // 计算帧应分发到的工作线程
+    size_t workerFor(common::ByteView frame) const;
+
+    size_t workerCount() const { return workers_.size(); }
+    uint64_t dispatchStalls() const { return stalls_; }
+
+    // 各工作线程统计（stop之后读取）
+    std::vector<WorkerStats> stats() const;
+
+private:
+    struct Worker {
+        explicit Worker(size_t ringSize, const Options& options)
+            : ring(ringSize), receiver(options) {}
+
+        common::SpscRing<common::ByteView> ring;
+        Receiver receiver;
+        WorkerStats stats;
+        std::thread thread;
+        uint64_t dispatched = 0;   // 分发线程写入
+        alignas(common::CACHE_LINE_SIZE) std::atomic<uint64_t> processed{0};   // 工作线程写入
+    };
+
+    PipelineConfig config_;
+    Handler handler_;
+    common::ToeplitzHash hash_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> stopping_{false};
+    bool running_ = false;
+    uint64_t stalls_ = 0;
+
+    // IPv6帧的工作线程（workerFor的一部分）
+    size_t workerForIPv6(common::ByteView frame) const;
+
+    void run(size_t index);
+    void process(size_t index, common::ByteView frame);
+};
+
+} // namespace receiver
+
+#endif // PIPELINE_H
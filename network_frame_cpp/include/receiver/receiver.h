@@ -5,34 +5,142 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include "application/application.h"
 #include "transport/udp.h"
 #include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "network/fragment.h"
 #include "datalink/ethernet.h"
+#include "trace/trace.h"
+#include "io/frame_io.h"
+#include "filter/filter.h"
+#include "demux/demux.h"
+#include "common/buffer_pool.h"
+#include "common/decode_status.h"
+#include "receiver/parsed_packet.h"
 
 namespace receiver {
 
-// 解析后的数据包结构
-struct ParsedPacket {
-    std::unique_ptr<datalink::EthernetFrame> ethernetFrame;
-    std::unique_ptr<network::IPv4Packet> ipv4Packet;
-    std::unique_ptr<transport::UDPDatagram> udpDatagram;
-    std::unique_ptr<application::Data> applicationData;
+// 零拷贝解析结果（各层视图均指向输入缓冲区）
+struct PacketView {
+    datalink::EthernetView ethernet;
+    network::IPv4View ipv4;    // ipVersion为4时有效
+    network::IPv6View ipv6;    // ipVersion为6时有效
+    transport::UDPView udp;
+    common::ByteView payload;
+    uint8_t ipVersion = 4;
+    bool pending = false;  // 该帧是IPv4分片且数据报尚未重组完成（此时只有ethernet/ipv4有效）
+    
+    bool isIPv6() const { return ipVersion == 6; }
+};
+
+// 接收选项
+struct Options {
+    // 校验IPv4首部与UDP校验和（可信链路上可关闭以节省一遍数据读取）
+    bool verifyChecksums = true;
+    // 重组IPv4分片；关闭时收到分片视为错误
+    bool reassemble = true;
+    network::ReassemblyConfig reassembly;
+    // 在解析前直接丢弃不匹配的帧（默认接受全部）
+    filter::Filter filter;
+};
+
+// 捕获文件处理统计
+struct CaptureStats {
+    uint64_t frames = 0;   // 读取的帧数
+    uint64_t bytes = 0;    // 读取的字节数
+    uint64_t decoded = 0;  // 成功解封装的数据报数
+    uint64_t fragments = 0;// 已缓存、等待重组的分片数
+    uint64_t errors = 0;   // 解封装失败的帧数，按原因的明细见Receiver::drops()
+    uint64_t filtered = 0; // 被过滤器丢弃的帧数
+    uint64_t skipped = 0;  // 不是IP/UDP（或首部残缺）而被跳过的帧数，明细见Receiver::demux()
 };
 
 // 解封装模块
 class Receiver {
 public:
     Receiver() = default;
+    explicit Receiver(const Options& options) : options_(options) {}
+    
+    // 解封装数据（不匹配过滤器的帧视为错误）：帧被拷贝一次，
+    // 只校验以太网与IPv4首部，UDP及以上各层在首次访问时解析
+    ParsedPacket decapsulate(common::ByteView data);
     
-    // 解封装数据
-    ParsedPacket decapsulate(const std::vector<uint8_t>& data);
+    // 解封装池化缓冲区中的帧：结果直接引用该缓冲区，不拷贝也不分配
+    // （分片重组得到的数据报仍拷贝到自有内存）
+    ParsedPacket decapsulate(const common::BufferRef& frame);
     
-    // 从文件读取并解封装数据
+    // 零拷贝解封装：只原地解析首部，不拷贝数据也不输出日志
+    // 分片重组完成时各视图指向重组缓冲区，在下一次解封装前有效
+    PacketView decapsulateView(common::ByteView data);
+    
+    // 不抛出异常的零拷贝解封装：失败时返回原因并计入drops()，
+    // 成功时写入view（分片未重组完成时返回Ok并置pending）
+    common::DecodeStatus tryDecapsulateView(common::ByteView data, PacketView& view);
+    
+    // 从文件读取并解封装数据（pcap文件取第一帧）
     ParsedPacket decapsulateFromFile(const std::string& filename);
     
+    // 零拷贝遍历pcap文件，每个成功解封装的帧调用一次handler
+    CaptureStats decapsulateCapture(const std::string& filename,
+                                    const std::function<void(const PacketView&)>& handler);
+    
+    // 零拷贝遍历输入后端（套接字等）中的帧，每个匹配过滤器且成功解封装的帧调用一次handler
+    // （非IP/UDP帧经协议分发表跳过）
+    CaptureStats decapsulateStream(io::FrameReader& reader,
+                                   const std::function<void(const PacketView&)>& handler);
+    
     // 从文件中提取应用层数据字符串
     std::string getApplicationData(const std::string& filename);
+    
+    // 跟踪输出（默认关闭）
+    trace::Tracer& tracer() { return tracer_; }
+    
+    const filter::Filter& packetFilter() const { return options_.filter; }
+    
+    // 协议分发表：流式接口先经它识别帧，可注册其他协议的处理函数
+    demux::Demux& demux() { return demux_; }
+    
+    // 识别帧的协议：可解封装的不带VLAN标签的IPv4/IPv6 UDP帧（含分片）返回true，
+    // 其余帧只计入分发统计并返回false，不抛出异常
+    bool classify(common::ByteView frame) {
+        demux::Packet packet;
+        return demux_.process(frame, packet) == demux::Result::Ok && packet.vlanTags == 0 &&
+               packet.ipVersion != 0 && packet.protocol == network::PROTOCOL_UDP;
+    }
+    
+    // 分片重组统计
+    network::ReassemblyStats reassemblyStats() const;
+    
+    // 按原因分类的丢弃计数（解封装失败与decapsulate中被过滤的帧；
+    // ParsedPacket首次访问UDP层时的失败不计入）
+    const common::DropCounters& drops() const { return drops_; }
+    void resetDrops() { drops_ = common::DropCounters(); }
+
+private:
+    Options options_;
+    trace::Tracer tracer_;
+    demux::Demux demux_;
+    std::unique_ptr<network::Reassembler> reassembler_;  // 收到第一个分片时创建
+    common::DropCounters drops_;
+    
+    // 解析以太网与IP首部（IPv6跳过扩展首部），IPv4分片交给重组器（未重组完成时置pending），
+    // 成功时输出上层协议号与上层首部起始的数据
+    common::DecodeStatus parseNetwork(common::ByteView data, PacketView& view,
+                                      uint8_t& protocol, common::ByteView& transport);
+    
+    // 解析各层首部（不校验UDP校验和）
+    common::DecodeStatus parseHeaders(common::ByteView data, PacketView& view);
+    
+    // 过滤并解析网络层，返回持有frame（或重组后数据报）的解析结果
+    ParsedPacket decapsulate(common::ByteView data, const common::BufferRef* frame);
+    
+    // 输出已解封装帧的跟踪记录
+    void traceView(const PacketView& view) const;
+    
+    // 按IP版本以对应的伪首部校验UDP校验和
+    static bool udpChecksumValid(const PacketView& view);
 };
 
 } // namespace receiver
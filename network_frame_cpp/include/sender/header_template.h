@@ -0,0 +1,70 @@
+#ifndef HEADER_TEMPLATE_H
+#define HEADER_TEMPLATE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "common/byte_view.h"
+#include "transport/udp.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "datalink/ethernet.h"
+
+namespace sender {
+
+struct Config;
+
+// 以太网+IPv4+UDP首部总长度，即封装所需的头部空间
+constexpr size_t FRAME_HEADROOM = datalink::ETHERNET_HEADER_SIZE + network::IPV4_HEADER_SIZE +
+                                  transport::UDP_HEADER_SIZE;
+// 以太网+IPv6+UDP首部总长度
+constexpr size_t FRAME_HEADROOM_IPV6 = datalink::ETHERNET_HEADER_SIZE + network::IPV6_HEADER_SIZE +
+                                       transport::UDP_HEADER_SIZE;
+
+// 预先编码的以太网+IP+UDP首部模板
+//
+// 构造时按发送配置把整个首部编码一次（长度、IP标识与校验和字段为0），并记下IPv4首部
+// 与UDP伪首部+首部中不变字段的校验和部分和。每帧只需拷贝模板，再填写长度、IP标识和
+// 两个校验和。模板构造后只读，可以在多个线程、生成器或回放器之间共享。
+class HeaderTemplate {
+public:
+    HeaderTemplate() = default;
+    explicit HeaderTemplate(const Config& config);
+
+    // 首部总长度（FRAME_HEADROOM或FRAME_HEADROOM_IPV6）
+    size_t size() const { return size_; }
+    bool ipv6() const { return ipv6_; }
+
+    // 模板字节
+    common::ByteView bytes() const { return common::ByteView(header_.data(), size_); }
+
+    // 不变字段的校验和部分和：IPv4首部（IPv6为0），伪首部（长度为0）与UDP首部
+    uint32_t ipSum() const { return ipSum_; }
+    uint32_t udpSum() const { return udpSum_; }
+
+    // 将载荷长度为payloadLen、载荷校验和部分和为payloadSum的帧的全部首部
+    // 写入out起始的size()字节，载荷过长时抛出异常
+    void write(uint8_t* out, size_t payloadLen, uint32_t payloadSum, uint16_t ipId = 0) const;
+
+    // 将完整的帧（首部+载荷）写入out，返回帧长度
+    size_t writeFrame(uint8_t* out, common::ByteView payload, uint16_t ipId = 0) const;
+
+    // 将以太网与IP首部模板（长度、IP标识与校验和字段为0）写入out，返回IP首部长度；
+    // ipSum为IPv4首部模板的部分和，pseudoSum为长度为0的伪首部部分和（供其他传输层复用）
+    static size_t writeNetwork(const Config& config, uint8_t* out, uint8_t protocol, uint8_t ipFlags,
+                               uint32_t& ipSum, uint32_t& pseudoSum);
+
+    // 在writeNetwork写出的IP首部上填写载荷长度，IPv4另填写标识与首部校验和
+    static void patchNetwork(uint8_t* ip, bool ipv6, uint32_t ipSum, uint16_t payloadLength, uint16_t ipId);
+
+private:
+    std::array<uint8_t, FRAME_HEADROOM_IPV6> header_{};
+    size_t size_ = 0;
+    bool ipv6_ = false;
+    uint32_t ipSum_ = 0;
+    uint32_t udpSum_ = 0;
+};
+
+} // namespace sender
+
+#endif // HEADER_TEMPLATE_H
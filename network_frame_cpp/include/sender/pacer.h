@@ -0,0 +1,112 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <cmath>
+#include "common/byte_view.h"
+#include "common/timing_wheel.h"
+#include "io/frame_io.h"
+
+namespace sender {
+
+// 速率单位：每秒报文数或每秒比特数（按帧长计）
+enum class RateUnit {
+    Pps,
+    Bps
+};
+
+// 实际速率相对请求速率的允许偏差
+constexpr double RATE_TOLERANCE = 0.01;
+
+struct FlowRate {
+    double rate = 0;
+    RateUnit unit = RateUnit::Pps;
+    size_t burst = 1;    // 令牌桶容量（报文数），也是一次连续发送的上限
+    // 发送落后理想时间线（唤醒延迟等）时仍可补发的最大落后时长，补发每刻度至多burst个报文；
+    // 超过该时长的落后部分被放弃，以免长时间停顿后突发大量报文
+    uint64_t catchUpNs = 2 * 1000 * 1000;
+};
+
+// 单条流的发送统计（间隔单位为纳秒）
+struct PacedFlowStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    double requestedPps = 0;
+    double achievedPps = 0;
+    double idealIntervalNs = 0;
+    double meanIntervalNs = 0;
+    double jitterNs = 0;         // 发送间隔的标准差
+    double maxDeviationNs = 0;   // 与理想间隔的最大偏差
+};
+
+struct PacerStats {
+    std::vector<PacedFlowStats> flows;
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t elapsedNs = 0;
+    uint64_t rounds = 0;         // 有报文到期的调度轮数（每轮flush一次）
+    double requestedPps = 0;
+
+    double achievedPps() const {
+        return elapsedNs > 0 ? static_cast<double>(packets) * 1e9 / static_cast<double>(elapsedNs) : 0.0;
+    }
+    double gbps() const {
+        return elapsedNs > 0 ? static_cast<double>(bytes) * 8.0 / static_cast<double>(elapsedNs) : 0.0;
+    }
+    // 实际速率与请求速率的相对偏差不超过tolerance
+    bool rateWithin(double tolerance = RATE_TOLERANCE) const {
+        return requestedPps > 0 && std::fabs(achievedPps() / requestedPps - 1.0) <= tolerance;
+    }
+};
+
+// 限速发送器
+//
+// 每条流一个令牌桶，按令牌补足所需时间把流挂到分层时间轮上，
+// 主循环用TSC时钟推进时间轮并发送到期流的帧。离下一次到期较远时先睡眠，
+// 最后一段忙等，以兼顾精度与CPU占用。令牌桶在burst之外还能积累catchUpNs
+// 的令牌，晚醒的报文随后补发，长期速率跟随理想时间线而不因唤醒延迟降低。
+class Pacer {
+public:
+    explicit Pacer(uint64_t tickNs = 256);
+
+    // 添加一条以frame为模板、按rate限速的流，返回流编号
+    size_t addFlow(std::vector<uint8_t> frame, const FlowRate& rate);
+
+    // 共发送packets个报文（各流按速率竞争）后返回
+    PacerStats run(io::FrameWriter& out, uint64_t packets);
+
+    size_t flowCount() const { return flows_.size(); }
+
+private:
+    struct Flow {
+        std::vector<uint8_t> frame;
+        double cost;          // 每个报文消耗的令牌数
+        double tokensPerNs;
+        double capacity;
+        size_t burst;
+        double tokens;
+        uint64_t refillNs;
+        uint64_t lastSendNs;
+        // 发送间隔的Welford统计
+        uint64_t intervals;
+        double mean;
+        double m2;
+        double maxDeviation;
+        PacedFlowStats stats;
+    };
+
+    uint64_t tickNs_;
+    std::vector<Flow> flows_;
+
+    void serve(Flow& flow, uint64_t nowNs, uint64_t& remaining, io::FrameWriter& out);
+};
+
+// 解析速率：N[pps|kpps|mpps|bps|kbps|mbps|gbps]，无单位时为pps
+FlowRate parseRate(const std::string& spec);
+
+} // namespace sender
+
+#endif // PACER_H
@@ -5,8 +5,17 @@
 #include <vector>
 #include <string>
 #include "application/application.h"
+#include "common/frame_batch.h"
+#include "common/buffer_pool.h"
+#include "transport/udp.h"
+#include "transport/tcp.h"
 #include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "network/fragment.h"
 #include "datalink/ethernet.h"
+#include "trace/trace.h"
+#include "io/frame_io.h"
+#include "sender/header_template.h"
 
 namespace sender {
 
@@ -18,24 +27,85 @@ struct Config {
     network::IPv4Address dstIP;
     datalink::MACAddress srcMAC;
     datalink::MACAddress dstMAC;
+    uint16_t mtu = network::DEFAULT_MTU;  // IP数据报（含首部）的最大长度
+    bool ipv6 = false;                    // 为true时以IPv6封装，使用下面的地址
+    network::IPv6Address srcIPv6{};
+    network::IPv6Address dstIPv6{};
 };
 
 // 封装模块
+//
+// 配置在构造后不变，UDP封装的首部模板在构造时建立，各封装接口共用
 class Sender {
 public:
     explicit Sender(const Config& config);
     
-    // 封装数据，返回完整的以太网帧字节
+    // 封装数据，返回完整的以太网帧字节（不按MTU切分，超过MTU的载荷应使用
+    // encapsulateFragments或encapsulateDatagrams）
     std::vector<uint8_t> encapsulate(const application::Data& data);
     
-    // 封装数据并保存到文件
+    // 封装到从pool分配的缓冲区：载荷追加到头部空间之后，首部原地插入，不分配堆内存
+    common::BufferRef encapsulate(const application::Data& data, common::BufferPool& pool);
+    
+    // 按MTU分片封装：超过MTU的UDP数据报被切分为多个IPv4分片，
+    // 同一数据报的分片使用按流生成的相同标识（IPv6不分片，超过MTU时抛出异常）
+    common::FrameBatch encapsulateFragments(const application::Data& data);
+    
+    // UDP分段卸载（模拟GSO）：把data按maxDatagramPayload()切分为多个完整的UDP数据报，
+    // 单遍写入同一批帧。与encapsulateSegments相同，首部模板只构建一次，各帧只改写长度、
+    // IP标识与校验和；接收方把每帧当作独立的数据报
+    common::FrameBatch encapsulateDatagrams(const application::Data& data);
+    
+    // TCP分段卸载（模拟网卡TSO）：把data按MSS切分为TCP报文段，单遍写入同一批帧。
+    // 首部模板每次调用只构建一次，各段拷贝模板后只改写序号、长度、IP标识与校验和；
+    // 各段带ACK，最后一段另带PSH。seq为第一个字节的序号，后续数据从seq+data.size()接续。
+    // 不输出跟踪记录（跟踪记录只描述UDP帧）
+    common::FrameBatch encapsulateSegments(const application::Data& data, uint32_t seq, uint32_t ack);
+    
+    // 批量封装：所有帧连续写入同一块内存，不逐帧分配也不输出日志
+    common::FrameBatch encapsulateBatch(const application::Data* data, size_t count);
+    common::FrameBatch encapsulateBatch(const std::vector<application::Data>& data);
+    
+    // 以payload为载荷封装一帧并追加到batch末尾（不经过Data，不输出日志）
+    void appendFrame(common::FrameBatch& batch, common::ByteView payload) const;
+    
+    // 封装数据并交给输出后端（后端支持原地写入时直接封装到后端缓冲区）
+    void send(const application::Data& data, io::FrameWriter& out);
+    
+    // 批量封装并交给输出后端（整批一次写入）
+    void send(const application::Data* data, size_t count, io::FrameWriter& out);
+    
+    // 封装数据并保存到文件（.pcap扩展名时写入pcap格式）
     void encapsulateAndSave(const application::Data& data, const std::string& filename);
     
     // 获取默认配置
     static Config defaultConfig();
+    
+    // 跟踪输出（默认关闭）
+    trace::Tracer& tracer() { return tracer_; }
+    
+    // 每帧的首部总长度（FRAME_HEADROOM或FRAME_HEADROOM_IPV6）
+    size_t headerSize() const { return headers_.size(); }
+    
+    // UDP封装的首部模板，可拷贝给生成器、回放器等其他发送端使用
+    const HeaderTemplate& headerTemplate() const { return headers_; }
+    
+    // TCP报文段的最大载荷（MTU减去IP与TCP首部），MTU过小时抛出异常
+    size_t mss() const;
+    
+    // 不超过MTU的UDP数据报的最大载荷（MTU减去IP与UDP首部），MTU过小时抛出异常
+    size_t maxDatagramPayload() const;
 
 private:
     Config config_;
+    HeaderTemplate headers_;
+    trace::Tracer tracer_;
+    
+    // 输出已封装帧的跟踪记录
+    void traceFrame(common::ByteView frame) const;
+    
+    // 一批帧的起始IP标识（IPv6没有标识字段，返回0）
+    uint16_t nextIPId(uint8_t protocol) const;
 };
 
 } // namespace sender
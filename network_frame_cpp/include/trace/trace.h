@@ -0,0 +1,133 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <ostream>
+#include "common/byte_view.h"
+#include "datalink/ethernet.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "transport/udp.h"
+
+// 编译期开关：为0时所有跟踪代码被编译器消除
+#ifndef NETWORK_FRAME_TRACE
+#define NETWORK_FRAME_TRACE 1
+#endif
+
+namespace trace {
+
+// 跟踪级别
+enum class Level : uint8_t {
+    Off = 0,      // 不输出
+    Summary = 1,  // 每个数据包一行
+    Detail = 2    // 逐层输出首部字段
+};
+
+// 数据流方向
+enum class Direction : uint8_t {
+    Encapsulate = 0,
+    Decapsulate = 1
+};
+
+// 数据包跟踪记录（payload仅在回调期间有效）
+struct PacketRecord {
+    Direction direction;
+    size_t frameSize;
+    datalink::EthernetHeader ethernet;
+    network::IPv4Header ipv4;  // 以太网类型为IPv4时有效
+    network::IPv6Header ipv6;  // 以太网类型为IPv6时有效
+    transport::UDPHeader udp;
+    common::ByteView payload;
+
+    bool isIPv6() const { return ethernet.etherType == datalink::ETHERTYPE_IPV6; }
+};
+
+// 文件读写跟踪记录
+struct FileRecord {
+    Direction direction;
+    const std::string& filename;
+    size_t bytes;
+};
+
+// 跟踪输出接口
+class Sink {
+public:
+    virtual ~Sink() = default;
+    virtual void packet(Level level, const PacketRecord& record) = 0;
+    virtual void file(Level level, const FileRecord& record) = 0;
+};
+
+// 文本输出（供人阅读）
+class TextSink : public Sink {
+public:
+    explicit TextSink(std::ostream& out) : out_(out) {}
+    void packet(Level level, const PacketRecord& record) override;
+    void file(Level level, const FileRecord& record) override;
+
+private:
+    std::ostream& out_;
+
+    void encapsulateDetail(const PacketRecord& record);
+    void decapsulateDetail(const PacketRecord& record);
+};
+
+// 紧凑二进制输出：每个数据包一条定长记录（小端）
+class BinarySink : public Sink {
+public:
+    static constexpr size_t PACKET_RECORD_SIZE = 48;
+
+    explicit BinarySink(std::ostream& out) : out_(out) {}
+    void packet(Level level, const PacketRecord& record) override;
+    void file(Level level, const FileRecord& record) override;
+
+private:
+    std::ostream& out_;
+};
+
+// 跟踪器：关闭时热路径只剩一次级别比较，不做任何格式化或系统调用
+class Tracer {
+public:
+    Tracer() = default;
+
+    // 设置输出目标与级别（sink为空等同于关闭）
+    void attach(std::shared_ptr<Sink> sink, Level level) {
+        sink_ = std::move(sink);
+        level_ = sink_ ? level : Level::Off;
+    }
+
+    void detach() { attach(nullptr, Level::Off); }
+
+    Level level() const { return level_; }
+
+    // 是否需要构造并输出跟踪记录
+    bool enabled(Level level = Level::Summary) const {
+#if NETWORK_FRAME_TRACE
+        return level != Level::Off && level_ >= level;
+#else
+        (void)level;
+        return false;
+#endif
+    }
+
+    void packet(const PacketRecord& record) const { sink_->packet(level_, record); }
+    void file(const FileRecord& record) const { sink_->file(level_, record); }
+
+private:
+    std::shared_ptr<Sink> sink_;
+    Level level_ = Level::Off;
+};
+
+// 由已解析的各层视图构造跟踪记录
+PacketRecord makeRecord(Direction direction, const datalink::EthernetView& ethernet,
+                        const network::IPv4View& ipv4, const transport::UDPView& udp);
+PacketRecord makeRecord(Direction direction, const datalink::EthernetView& ethernet,
+                        const network::IPv6View& ipv6, const transport::UDPView& udp);
+
+// 解析级别名称："off"、"summary"、"detail"
+Level parseLevel(const std::string& name);
+
+} // namespace trace
+
+#endif // TRACE_H
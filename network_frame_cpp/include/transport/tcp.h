@@ -0,0 +1,158 @@
+#ifndef TCP_H
+#define TCP_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "common/byte_view.h"
+#include "common/byte_storage.h"
+#include "common/header_fields.h"
+#include "common/decode_status.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "transport/udp.h"
+
+namespace transport {
+
+constexpr size_t TCP_HEADER_SIZE = 20;      // 不含选项
+constexpr size_t TCP_MAX_HEADER_SIZE = 60;
+constexpr uint16_t TCP_DEFAULT_WINDOW = 65535;
+
+// TCP标志位
+constexpr uint16_t TCP_FLAG_FIN = 0x01;
+constexpr uint16_t TCP_FLAG_SYN = 0x02;
+constexpr uint16_t TCP_FLAG_RST = 0x04;
+constexpr uint16_t TCP_FLAG_PSH = 0x08;
+constexpr uint16_t TCP_FLAG_ACK = 0x10;
+constexpr uint16_t TCP_FLAG_URG = 0x20;
+
+// TCP首部结构
+struct TCPHeader {
+    uint16_t srcPort;
+    uint16_t dstPort;
+    uint32_t seq;            // 序号
+    uint32_t ack;            // 确认号
+    uint8_t dataOffset;      // 首部长度（以4字节为单位）
+    uint16_t flags;          // 保留位与标志位（低8位为CWR..FIN）
+    uint16_t window;
+    uint16_t checksum;
+    uint16_t urgentPointer;
+};
+
+// TCP首部（不含选项）字段布局，端口与UDP共用
+namespace fields {
+using SeqNumber = common::BitField<32, 32>;
+using AckNumber = common::BitField<64, 32>;
+using DataOffset = common::BitField<96, 4>;
+using TCPFlags = common::BitField<100, 12>;
+using Window = common::BitField<112, 16>;
+using TCPChecksum = common::BitField<128, 16>;
+using UrgentPointer = common::BitField<144, 16>;
+
+using TCPCodec = common::HeaderCodec<TCPHeader, TCP_HEADER_SIZE,
+    common::Bind<&TCPHeader::srcPort, SrcPort>,
+    common::Bind<&TCPHeader::dstPort, DstPort>,
+    common::Bind<&TCPHeader::seq, SeqNumber>,
+    common::Bind<&TCPHeader::ack, AckNumber>,
+    common::Bind<&TCPHeader::dataOffset, DataOffset>,
+    common::Bind<&TCPHeader::flags, TCPFlags>,
+    common::Bind<&TCPHeader::window, Window>,
+    common::Bind<&TCPHeader::checksum, TCPChecksum>,
+    common::Bind<&TCPHeader::urgentPointer, UrgentPointer>>;
+} // namespace fields
+
+// TCP报文段只读视图（原地解析首部，载荷指向原缓冲区）
+//
+// TCP没有长度字段，报文段长度即IP载荷长度，调用方应传入按IP长度截断的数据。
+class TCPView {
+public:
+    TCPView() = default;
+
+    // 解析TCP报文段，数据偏移非法时抛出异常
+    static TCPView parse(common::ByteView data);
+    // 不抛出异常的版本：成功时写入out并返回Ok（不校验校验和）
+    static common::DecodeStatus tryParse(common::ByteView data, TCPView& out) noexcept;
+
+    uint16_t srcPort() const { return fields::SrcPort::get(data_.data()); }
+    uint16_t dstPort() const { return fields::DstPort::get(data_.data()); }
+    uint32_t seq() const { return fields::SeqNumber::get(data_.data()); }
+    uint32_t ack() const { return fields::AckNumber::get(data_.data()); }
+    uint8_t dataOffset() const { return fields::DataOffset::get(data_.data()); }
+    size_t headerLength() const { return static_cast<size_t>(dataOffset()) * 4; }
+    uint16_t flags() const { return fields::TCPFlags::get(data_.data()); }
+    uint16_t window() const { return fields::Window::get(data_.data()); }
+    uint16_t checksum() const { return fields::TCPChecksum::get(data_.data()); }
+    uint16_t urgentPointer() const { return fields::UrgentPointer::get(data_.data()); }
+    TCPHeader header() const { return fields::TCPCodec::decode(data_.data()); }
+
+    // 校验伪首部+首部（含选项）+数据，TCP校验和是必需的
+    bool checksumValid(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) const;
+    bool checksumValid(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) const;
+
+    // 整个报文段、选项与有效载荷
+    common::ByteView bytes() const { return data_; }
+    common::ByteView options() const {
+        return data_.subview(TCP_HEADER_SIZE, headerLength() - TCP_HEADER_SIZE);
+    }
+    common::ByteView payload() const { return data_.subview(headerLength()); }
+
+private:
+    explicit TCPView(common::ByteView data) : data_(data) {}
+
+    common::ByteView data_;
+};
+
+// TCP报文段类（不含选项）
+class TCPSegment {
+public:
+    TCPSegment() = default;
+    TCPSegment(uint16_t srcPort, uint16_t dstPort, uint32_t seq, uint32_t ack, uint16_t flags,
+               const std::vector<uint8_t>& payload);
+    // 选项被丢弃，数据偏移重置为5
+    explicit TCPSegment(const TCPView& view);
+
+    // 编码为字节数组
+    std::vector<uint8_t> encode() const;
+
+    // 将首部编码到out起始的20字节
+    static void encodeHeader(const TCPHeader& header, uint8_t* out) {
+        fields::TCPCodec::encode(header, out);
+    }
+
+    // 由伪首部部分和（pseudoHeaderSum，长度为0）、首部（校验和字段视为0）与载荷部分和计算校验和
+    static uint16_t calculateChecksum(uint32_t pseudoSum, const TCPHeader& header,
+                                      uint32_t payloadSum, size_t payloadLen);
+
+    // 根据IP地址填写本报文段的校验和
+    void updateChecksum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP);
+    void updateChecksum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP);
+
+    // 从字节数组解码
+    static TCPSegment decode(common::ByteView data);
+    // 不抛出解析异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryDecode(common::ByteView data, TCPSegment& out);
+
+    // 获取有效载荷
+    std::vector<uint8_t> getPayload() const;
+
+    // 获取有效载荷视图（不拷贝）
+    common::ByteView payloadView() const { return payload_.view(); }
+
+    // 获取首部信息
+    TCPHeader getHeader() const;
+
+    // 标志位的文本形式，如"ACK|PSH"
+    static std::string flagsToString(uint16_t flags);
+
+    // 字符串表示
+    std::string toString() const;
+
+private:
+    TCPHeader header_{};
+    common::ByteStorage payload_;
+};
+
+} // namespace transport
+
+#endif // TCP_H
@@ -5,6 +5,13 @@
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include "common/byte_view.h"
+#include "common/packet_buffer.h"
+#include "common/byte_storage.h"
+#include "common/header_fields.h"
+#include "common/decode_status.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
 
 namespace transport {
 
@@ -15,7 +22,60 @@ struct UDPHeader {
     uint16_t srcPort;   // 源端口
     uint16_t dstPort;   // 目的端口
     uint16_t length;    // UDP长度（首部+数据）
-    uint16_t checksum;  // 校验和（可选，置0）
+    uint16_t checksum;  // 校验和（0表示未计算）
+};
+
+// UDP首部字段布局
+namespace fields {
+using SrcPort = common::BitField<0, 16>;
+using DstPort = common::BitField<16, 16>;
+using Length = common::BitField<32, 16>;
+using Checksum = common::BitField<48, 16>;
+
+using UDPCodec = common::HeaderCodec<UDPHeader, UDP_HEADER_SIZE,
+    common::Bind<&UDPHeader::srcPort, SrcPort>,
+    common::Bind<&UDPHeader::dstPort, DstPort>,
+    common::Bind<&UDPHeader::length, Length>,
+    common::Bind<&UDPHeader::checksum, Checksum>>;
+} // namespace fields
+
+// IPv4伪首部（源/目的地址、协议、UDP长度）的校验和部分和
+uint32_t pseudoHeaderSum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP,
+                         uint8_t protocol, uint16_t length);
+
+// IPv6伪首部（源/目的地址、上层长度、下一首部）的校验和部分和
+uint32_t pseudoHeaderSum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP,
+                         uint8_t protocol, uint32_t length);
+
+// UDP数据报只读视图（原地解析首部，载荷指向原缓冲区）
+class UDPView {
+public:
+    UDPView() = default;
+
+    // 解析UDP数据报，长度字段非法时抛出异常
+    static UDPView parse(common::ByteView data);
+    // 不抛出异常的版本：成功时写入out并返回Ok（不校验校验和）
+    static common::DecodeStatus tryParse(common::ByteView data, UDPView& out) noexcept;
+
+    uint16_t srcPort() const { return fields::SrcPort::get(data_.data()); }
+    uint16_t dstPort() const { return fields::DstPort::get(data_.data()); }
+    uint16_t length() const { return fields::Length::get(data_.data()); }
+    uint16_t checksum() const { return fields::Checksum::get(data_.data()); }
+    UDPHeader header() const { return fields::UDPCodec::decode(data_.data()); }
+
+    // 按RFC 768校验伪首部+首部+数据（校验和为0表示发送方未计算，视为有效）
+    bool checksumValid(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) const;
+    // IPv6下校验和是必需的（RFC 8200），为0视为无效
+    bool checksumValid(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) const;
+
+    // 整个数据报（按长度字段截断）与有效载荷
+    common::ByteView bytes() const { return data_; }
+    common::ByteView payload() const { return data_.subview(UDP_HEADER_SIZE); }
+
+private:
+    explicit UDPView(common::ByteView data) : data_(data) {}
+
+    common::ByteView data_;
 };
 
 // UDP数据报类
@@ -23,16 +83,52 @@ class UDPDatagram {
 public:
     UDPDatagram() = default;
     UDPDatagram(uint16_t srcPort, uint16_t dstPort, const std::vector<uint8_t>& payload);
+    explicit UDPDatagram(const UDPView& view);
+    // 以view的首部和payload（通常引用view所在的池化缓冲区）构造，不拷贝载荷
+    UDPDatagram(const UDPView& view, common::ByteStorage payload);
 
     // 编码为字节数组
     std::vector<uint8_t> encode() const;
     
+    // 将首部编码到out起始的8字节
+    static void encodeHeader(const UDPHeader& header, uint8_t* out) {
+        fields::UDPCodec::encode(header, out);
+    }
+    
+    // 以缓冲区现有内容为载荷，在其前部插入UDP首部
+    // payloadSum为载荷的校验和部分和（通常在拷贝载荷时由common::checksumCopy顺带算出）
+    static void prependHeader(common::PacketBuffer& buf, uint16_t srcPort, uint16_t dstPort,
+                              const network::IPv4Address& srcIP, const network::IPv4Address& dstIP,
+                              uint32_t payloadSum);
+    static void prependHeader(common::PacketBuffer& buf, uint16_t srcPort, uint16_t dstPort,
+                              const network::IPv6Address& srcIP, const network::IPv6Address& dstIP,
+                              uint32_t payloadSum);
+    
+    // 由伪首部、首部（校验和字段视为0）和载荷部分和计算校验和，结果为0时用0xFFFF表示
+    static uint16_t calculateChecksum(const network::IPv4Address& srcIP,
+                                      const network::IPv4Address& dstIP,
+                                      const UDPHeader& header, uint32_t payloadSum);
+    static uint16_t calculateChecksum(const network::IPv6Address& srcIP,
+                                      const network::IPv6Address& dstIP,
+                                      const UDPHeader& header, uint32_t payloadSum);
+    // pseudoSum为pseudoHeaderSum的结果（同一对地址可预先算好重复使用）
+    static uint16_t calculateChecksum(uint32_t pseudoSum, const UDPHeader& header, uint32_t payloadSum);
+    
+    // 根据IP地址填写本数据报的校验和
+    void updateChecksum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP);
+    void updateChecksum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP);
+    
     // 从字节数组解码
-    static UDPDatagram decode(const std::vector<uint8_t>& data);
+    static UDPDatagram decode(common::ByteView data);
+    // 不抛出解析异常的版本：成功时写入out并返回Ok
+    static common::DecodeStatus tryDecode(common::ByteView data, UDPDatagram& out);
     
     // 获取有效载荷
     std::vector<uint8_t> getPayload() const;
     
+    // 获取有效载荷视图（不拷贝）
+    common::ByteView payloadView() const { return payload_.view(); }
+    
     // 获取首部信息
     UDPHeader getHeader() const;
     
@@ -41,7 +137,7 @@ public:
 
 private:
     UDPHeader header_{};
-    std::vector<uint8_t> payload_;
+    common::ByteStorage payload_;
 };
 
 } // namespace transport
@@ -3,19 +3,31 @@
 namespace application {
 
 Data::Data(const std::string& payload) 
-    : payload_(payload.begin(), payload.end()) {
+    : payload_(common::ByteView(reinterpret_cast<const uint8_t*>(payload.data()), payload.size())) {
 }
 
 Data::Data(const std::vector<uint8_t>& payload) 
     : payload_(payload) {
 }
 
+Data::Data(std::vector<uint8_t>&& payload)
+    : payload_(std::move(payload)) {
+}
+
+Data::Data(common::ByteView payload)
+    : payload_(payload) {
+}
+
+Data::Data(common::ByteStorage payload)
+    : payload_(std::move(payload)) {
+}
+
 std::vector<uint8_t> Data::getPayload() const {
-    return payload_;
+    return payload_.toVector();
 }
 
 std::string Data::getPayloadString() const {
-    return std::string(payload_.begin(), payload_.end());
+    return payload_.view().toString();
 }
 
 size_t Data::size() const {
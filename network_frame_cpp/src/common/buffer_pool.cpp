@@ -0,0 +1,223 @@
+#include "common/buffer_pool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace common {
+
+namespace {
+
+constexpr size_t CACHE_LINE = 64;
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr size_t MAX_THREAD_CACHES = 64;
+
+// 存活的缓冲池与空闲线程编号（故意不析构，线程局部对象析构时仍可访问）
+struct SlotRegistry {
+    std::mutex mutex;
+    std::vector<BufferPool*> pools;
+    std::vector<size_t> freeSlots;
+    size_t nextSlot = 0;
+};
+
+SlotRegistry& registry() {
+    static SlotRegistry* instance = new SlotRegistry();
+    return *instance;
+}
+
+} // namespace
+
+// 线程首次使用缓冲池时取得编号，退出时把各缓冲池中该编号的缓存归还并回收编号
+struct BufferPool::ThreadSlot {
+    size_t slot;
+
+    ThreadSlot() {
+        SlotRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (reg.freeSlots.empty()) {
+            slot = reg.nextSlot++;
+        } else {
+            slot = reg.freeSlots.back();
+            reg.freeSlots.pop_back();
+        }
+    }
+
+    ~ThreadSlot() {
+        SlotRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (BufferPool* pool : reg.pools) {
+            pool->flushCache(slot);
+        }
+        reg.freeSlots.push_back(slot);
+    }
+};
+
+void BufferRef::append(ByteView bytes) {
+    uint8_t* out = append(bytes.size());
+    std::copy(bytes.begin(), bytes.end(), out);
+}
+
+void BufferRef::trimFront(size_t len) noexcept {
+    desc_->head += static_cast<uint32_t>(std::min(len, size()));
+}
+
+void BufferRef::trimBack(size_t len) noexcept {
+    desc_->tail -= static_cast<uint32_t>(std::min(len, size()));
+}
+
+BufferPool::BufferPool(const BufferPoolConfig& config)
+    : config_(config), stride_((config.bufferSize + CACHE_LINE - 1) & ~(CACHE_LINE - 1)),
+      mappedSize_(0), memory_(nullptr), hugePages_(false) {
+    if (config_.buffers == 0 || config_.buffers > UINT32_MAX || stride_ == 0 ||
+        stride_ > UINT32_MAX || config_.headroom > stride_) {
+        throw std::runtime_error("Invalid buffer pool configuration");
+    }
+    
+    size_t bytes = stride_ * config_.buffers;
+#if defined(__linux__)
+    void* memory = MAP_FAILED;
+    if (config_.hugePages) {
+        mappedSize_ = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        memory = mmap(nullptr, mappedSize_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        hugePages_ = memory != MAP_FAILED;
+    }
+    if (memory == MAP_FAILED) {
+        mappedSize_ = bytes;
+        memory = mmap(nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error(std::string("Failed to map buffer pool: ") + std::strerror(errno));
+        }
+        if (config_.hugePages) {
+            // 没有预留的大页时请求透明大页
+            madvise(memory, mappedSize_, MADV_HUGEPAGE);
+        }
+    }
+    memory_ = static_cast<uint8_t*>(memory);
+#else
+    mappedSize_ = bytes;
+    memory_ = static_cast<uint8_t*>(::operator new(bytes, std::align_val_t(CACHE_LINE)));
+#endif
+    
+    descriptors_.reset(new BufferDescriptor[config_.buffers]);
+    free_.reserve(config_.buffers);
+    for (size_t i = config_.buffers; i-- > 0;) {
+        BufferDescriptor& desc = descriptors_[i];
+        desc.index = static_cast<uint32_t>(i);
+        desc.base = memory_ + i * stride_;
+        desc.pool = this;
+        free_.push_back(static_cast<uint32_t>(i));
+    }
+    
+    caches_.reset(new ThreadCache[MAX_THREAD_CACHES]);
+    if (config_.cacheSize > 0) {
+        for (size_t i = 0; i < MAX_THREAD_CACHES; ++i) {
+            caches_[i].items.resize(config_.cacheSize);
+        }
+    }
+    
+    SlotRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.pools.push_back(this);
+}
+
+BufferPool::~BufferPool() {
+    {
+        SlotRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.pools.erase(std::find(reg.pools.begin(), reg.pools.end(), this));
+    }
+#if defined(__linux__)
+    munmap(memory_, mappedSize_);
+#else
+    ::operator delete(memory_, std::align_val_t(CACHE_LINE));
+#endif
+}
+
+BufferPool::ThreadCache* BufferPool::localCache() {
+    thread_local ThreadSlot threadSlot;
+    size_t slot = threadSlot.slot;
+    if (config_.cacheSize == 0 || slot >= MAX_THREAD_CACHES) {
+        return nullptr;
+    }
+    return &caches_[slot];
+}
+
+BufferRef BufferPool::tryAllocate() {
+    uint32_t index;
+    ThreadCache* cache = localCache();
+    if (cache) {
+        if (cache->count == 0) {
+            // 缓存空时从全局栈一次取回半个缓存
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_t take = std::min(free_.size(), std::max<size_t>(config_.cacheSize / 2, 1));
+            std::copy(free_.end() - static_cast<std::ptrdiff_t>(take), free_.end(), cache->items.begin());
+            free_.resize(free_.size() - take);
+            cache->count = take;
+        }
+        if (cache->count == 0) {
+            return BufferRef();
+        }
+        index = cache->items[--cache->count];
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            return BufferRef();
+        }
+        index = free_.back();
+        free_.pop_back();
+    }
+    
+    BufferDescriptor& desc = descriptors_[index];
+    desc.head = static_cast<uint32_t>(config_.headroom);
+    desc.tail = desc.head;
+    desc.refs.store(1, std::memory_order_relaxed);
+    return BufferRef(&desc);
+}
+
+BufferRef BufferPool::allocate() {
+    BufferRef buffer = tryAllocate();
+    if (!buffer) {
+        throw std::runtime_error("Buffer pool exhausted");
+    }
+    return buffer;
+}
+
+void BufferPool::release(BufferDescriptor* desc) {
+    ThreadCache* cache = localCache();
+    if (cache) {
+        if (cache->count == config_.cacheSize) {
+            // 缓存满时把一半归还全局栈
+            size_t give = std::max<size_t>(config_.cacheSize / 2, 1);
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.insert(free_.end(), cache->items.begin() + static_cast<std::ptrdiff_t>(cache->count - give),
+                         cache->items.begin() + static_cast<std::ptrdiff_t>(cache->count));
+            cache->count -= give;
+        }
+        cache->items[cache->count++] = desc->index;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(desc->index);
+}
+
+void BufferPool::flushCache(size_t slot) {
+    if (slot >= MAX_THREAD_CACHES) {
+        return;
+    }
+    ThreadCache& cache = caches_[slot];
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.insert(free_.end(), cache.items.begin(),
+                 cache.items.begin() + static_cast<std::ptrdiff_t>(cache.count));
+    cache.count = 0;
+}
+
+size_t BufferPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+} // namespace common
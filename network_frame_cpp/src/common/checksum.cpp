@@ -0,0 +1,290 @@
+#include "common/checksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CHECKSUM_X86 1
+#include <immintrin.h>
+#else
+#define CHECKSUM_X86 0
+#endif
+
+namespace common {
+
+namespace {
+
+// 短于该长度时SIMD的启动开销得不偿失，直接使用标量实现
+constexpr size_t SIMD_THRESHOLD = 64;
+
+// 带循环进位的64位加法
+inline uint64_t addCarry(uint64_t a, uint64_t b) {
+    uint64_t sum = a + b;
+    return sum + (sum < b);
+}
+
+// 将主机字节序下的64位反码和折叠为网络字节序的16位部分和
+inline uint32_t foldNative(uint64_t sum) {
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    uint32_t folded = static_cast<uint32_t>(sum);
+    folded = (folded & 0xFFFF) + (folded >> 16);
+    folded = (folded & 0xFFFF) + (folded >> 16);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    folded = static_cast<uint16_t>((folded >> 8) | (folded << 8));
+#endif
+    return folded;
+}
+
+// 主机字节序累加：反码和与字节序无关，只需在最后交换一次字节
+uint64_t sumNative(const uint8_t* p, size_t len, uint64_t sum) {
+    while (len >= 32) {
+        uint64_t w[4];
+        std::memcpy(w, p, sizeof(w));
+        sum = addCarry(sum, w[0]);
+        sum = addCarry(sum, w[1]);
+        sum = addCarry(sum, w[2]);
+        sum = addCarry(sum, w[3]);
+        p += 32;
+        len -= 32;
+    }
+    while (len >= 8) {
+        uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        sum = addCarry(sum, w);
+        p += 8;
+        len -= 8;
+    }
+    if (len >= 4) {
+        uint32_t w;
+        std::memcpy(&w, p, sizeof(w));
+        sum = addCarry(sum, w);
+        p += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        uint16_t w;
+        std::memcpy(&w, p, sizeof(w));
+        sum = addCarry(sum, w);
+        p += 2;
+        len -= 2;
+    }
+    if (len > 0) {
+        // 奇数长度：最后一个字节作为高位字节，低位补0
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        sum = addCarry(sum, p[0]);
+#else
+        sum = addCarry(sum, static_cast<uint64_t>(p[0]) << 8);
+#endif
+    }
+    return sum;
+}
+
+// 边拷贝边累加的标量实现
+uint64_t copyNative(uint8_t* dst, const uint8_t* src, size_t len, uint64_t sum) {
+    while (len >= 32) {
+        uint64_t w[4];
+        std::memcpy(w, src, sizeof(w));
+        std::memcpy(dst, w, sizeof(w));
+        sum = addCarry(sum, w[0]);
+        sum = addCarry(sum, w[1]);
+        sum = addCarry(sum, w[2]);
+        sum = addCarry(sum, w[3]);
+        src += 32;
+        dst += 32;
+        len -= 32;
+    }
+    if (len != 0) {
+        std::memcpy(dst, src, len);
+    }
+    return sumNative(src, len, sum);
+}
+
+#if CHECKSUM_X86
+
+uint64_t sumSSE2(const uint8_t* p, size_t len) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = zero;
+    __m128i acc1 = zero;
+    // 每个32位字零扩展到64位通道后累加，2^32次加法内不会溢出
+    while (len >= 32) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(a, zero));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(a, zero));
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(b, zero));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(b, zero));
+        p += 32;
+        len -= 32;
+    }
+    uint64_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 2), acc1);
+    uint64_t sum = addCarry(addCarry(lanes[0], lanes[1]), addCarry(lanes[2], lanes[3]));
+    return sumNative(p, len, sum);
+}
+
+__attribute__((target("avx2")))
+uint64_t sumAVX2(const uint8_t* p, size_t len) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero;
+    __m256i acc1 = zero;
+    while (len >= 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(a, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(a, zero));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(b, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(b, zero));
+        p += 64;
+        len -= 64;
+    }
+    uint64_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 4), acc1);
+    uint64_t sum = 0;
+    for (uint64_t lane : lanes) {
+        sum = addCarry(sum, lane);
+    }
+    return sumNative(p, len, sum);
+}
+
+__attribute__((target("avx2")))
+uint64_t copyAVX2(uint8_t* dst, const uint8_t* src, size_t len) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero;
+    __m256i acc1 = zero;
+    while (len >= 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), b);
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(a, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(a, zero));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(b, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(b, zero));
+        src += 64;
+        dst += 64;
+        len -= 64;
+    }
+    uint64_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 4), acc1);
+    uint64_t sum = 0;
+    for (uint64_t lane : lanes) {
+        sum = addCarry(sum, lane);
+    }
+    return copyNative(dst, src, len, sum);
+}
+
+#endif // CHECKSUM_X86
+
+using PartialFn = uint32_t (*)(const uint8_t*, size_t, uint32_t);
+
+PartialFn selectImplementation() {
+#if CHECKSUM_X86
+    __builtin_cpu_init();
+#endif
+    if (checksumHasAVX2()) {
+        return checksumPartialAVX2;
+    }
+    if (checksumHasSSE2()) {
+        return checksumPartialSSE2;
+    }
+    return checksumPartialScalar;
+}
+
+// 首次使用时按CPUID选择一次实现
+PartialFn implementation() {
+    static const PartialFn impl = selectImplementation();
+    return impl;
+}
+
+} // namespace
+
+uint32_t checksumPartialScalar(const uint8_t* data, size_t len, uint32_t initial) {
+    return checksumAdd(initial, foldNative(sumNative(data, len, 0)));
+}
+
+uint32_t checksumPartialSSE2(const uint8_t* data, size_t len, uint32_t initial) {
+#if CHECKSUM_X86
+    return checksumAdd(initial, foldNative(sumSSE2(data, len)));
+#else
+    return checksumPartialScalar(data, len, initial);
+#endif
+}
+
+uint32_t checksumPartialAVX2(const uint8_t* data, size_t len, uint32_t initial) {
+#if CHECKSUM_X86
+    return checksumAdd(initial, foldNative(sumAVX2(data, len)));
+#else
+    return checksumPartialScalar(data, len, initial);
+#endif
+}
+
+bool checksumHasSSE2() {
+#if CHECKSUM_X86
+    return __builtin_cpu_supports("sse2");
+#else
+    return false;
+#endif
+}
+
+bool checksumHasAVX2() {
+#if CHECKSUM_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+const char* checksumImplementation() {
+    PartialFn impl = implementation();
+    if (impl == checksumPartialAVX2) {
+        return "avx2";
+    }
+    if (impl == checksumPartialSSE2) {
+        return "sse2";
+    }
+    return "scalar";
+}
+
+uint32_t checksumPartial(const uint8_t* data, size_t len, uint32_t initial) {
+    if (len < SIMD_THRESHOLD) {
+        return checksumPartialScalar(data, len, initial);
+    }
+    return implementation()(data, len, initial);
+}
+
+uint32_t checksumCopy(uint8_t* dst, const uint8_t* src, size_t len, uint32_t initial) {
+#if CHECKSUM_X86
+    if (len >= SIMD_THRESHOLD && implementation() == checksumPartialAVX2) {
+        return checksumAdd(initial, foldNative(copyAVX2(dst, src, len)));
+    }
+#endif
+    return checksumAdd(initial, foldNative(copyNative(dst, src, len, 0)));
+}
+
+uint16_t checksumFinish(uint32_t partial) {
+    while (partial > 0xFFFF) {
+        partial = (partial & 0xFFFF) + (partial >> 16);
+    }
+    return static_cast<uint16_t>(~partial);
+}
+
+uint16_t checksumUpdate16(uint16_t oldChecksum, uint16_t oldValue, uint16_t newValue) {
+    // HC' = ~(~HC + ~m + m')
+    uint32_t sum = static_cast<uint16_t>(~oldChecksum);
+    sum += static_cast<uint16_t>(~oldValue);
+    sum += newValue;
+    return checksumFinish(sum);
+}
+
+uint16_t checksumUpdate32(uint16_t oldChecksum, uint32_t oldValue, uint32_t newValue) {
+    uint32_t sum = static_cast<uint16_t>(~oldChecksum);
+    sum += static_cast<uint16_t>(~(oldValue >> 16));
+    sum += static_cast<uint16_t>(~oldValue);
+    sum += newValue >> 16;
+    sum += newValue & 0xFFFF;
+    return checksumFinish(sum);
+}
+
+} // namespace common
@@ -0,0 +1,66 @@
+#include "common/decode_status.h"
+#include <stdexcept>
+
+namespace common {
+
+const char* decodeStatusName(DecodeStatus status) {
+    switch (status) {
+        case DecodeStatus::Ok: return "ok";
+        case DecodeStatus::EthernetTooShort: return "short Ethernet frame";
+        case DecodeStatus::NotIP: return "not IP";
+        case DecodeStatus::IPv4TooShort: return "short IPv4 header";
+        case DecodeStatus::BadIPVersion: return "bad IP version";
+        case DecodeStatus::BadIPHeaderLength: return "bad IHL";
+        case DecodeStatus::BadIPTotalLength: return "bad IPv4 total length";
+        case DecodeStatus::BadIPChecksum: return "bad IPv4 checksum";
+        case DecodeStatus::FragmentRejected: return "fragment rejected";
+        case DecodeStatus::IPv6TooShort: return "short IPv6 header";
+        case DecodeStatus::BadIPv6PayloadLength: return "bad IPv6 payload length";
+        case DecodeStatus::BadIPv6Extension: return "bad IPv6 extension header";
+        case DecodeStatus::IPv6Fragment: return "IPv6 fragment";
+        case DecodeStatus::NotUDP: return "not UDP";
+        case DecodeStatus::UDPTooShort: return "short UDP header";
+        case DecodeStatus::BadUDPLength: return "bad UDP length";
+        case DecodeStatus::BadUDPChecksum: return "bad UDP checksum";
+        case DecodeStatus::TCPTooShort: return "short TCP header";
+        case DecodeStatus::BadTCPDataOffset: return "bad TCP data offset";
+        case DecodeStatus::Filtered: return "filtered";
+        case DecodeStatus::Incomplete: return "incomplete datagram";
+        case DecodeStatus::Count: break;
+    }
+    return "unknown";
+}
+
+const char* decodeStatusMessage(DecodeStatus status) {
+    switch (status) {
+        case DecodeStatus::Ok: return "Ok";
+        case DecodeStatus::EthernetTooShort: return "Data too short for Ethernet header";
+        case DecodeStatus::NotIP: return "EtherType is not IPv4 (0x0800) or IPv6 (0x86DD)";
+        case DecodeStatus::IPv4TooShort: return "Data too short for IPv4 header";
+        case DecodeStatus::BadIPVersion: return "Invalid IP version";
+        case DecodeStatus::BadIPHeaderLength: return "Invalid IP header length";
+        case DecodeStatus::BadIPTotalLength: return "Invalid total length";
+        case DecodeStatus::BadIPChecksum: return "Invalid IPv4 header checksum";
+        case DecodeStatus::FragmentRejected: return "IPv4 fragment received with reassembly disabled";
+        case DecodeStatus::IPv6TooShort: return "Data too short for IPv6 header";
+        case DecodeStatus::BadIPv6PayloadLength: return "Invalid IPv6 payload length";
+        case DecodeStatus::BadIPv6Extension: return "Invalid IPv6 extension header chain";
+        case DecodeStatus::IPv6Fragment: return "IPv6 fragment received (reassembly is IPv4 only)";
+        case DecodeStatus::NotUDP: return "Protocol is not UDP (17)";
+        case DecodeStatus::UDPTooShort: return "Data too short for UDP header";
+        case DecodeStatus::BadUDPLength: return "Invalid UDP length field";
+        case DecodeStatus::BadUDPChecksum: return "Invalid UDP checksum";
+        case DecodeStatus::TCPTooShort: return "Data too short for TCP header";
+        case DecodeStatus::BadTCPDataOffset: return "Invalid TCP data offset";
+        case DecodeStatus::Filtered: return "Frame rejected by filter";
+        case DecodeStatus::Incomplete: return "Incomplete IPv4 datagram: waiting for more fragments";
+        case DecodeStatus::Count: break;
+    }
+    return "Unknown decode error";
+}
+
+void throwDecodeError(DecodeStatus status) {
+    throw std::runtime_error(decodeStatusMessage(status));
+}
+
+} // namespace common
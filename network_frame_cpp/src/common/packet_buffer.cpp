@@ -0,0 +1,42 @@
+#include "common/packet_buffer.h"
+#include <algorithm>
+
+namespace common {
+
+PacketBuffer::PacketBuffer(size_t headroom, size_t payloadCapacity)
+    : storage_(headroom + payloadCapacity), head_(headroom), tail_(headroom) {
+}
+
+uint8_t* PacketBuffer::prepend(size_t len) {
+    if (len > head_) {
+        throw std::runtime_error("Not enough headroom in packet buffer");
+    }
+    head_ -= len;
+    return storage_.data() + head_;
+}
+
+uint8_t* PacketBuffer::append(size_t len) {
+    if (tail_ + len > storage_.size()) {
+        storage_.resize(tail_ + len);
+    }
+    uint8_t* out = storage_.data() + tail_;
+    tail_ += len;
+    return out;
+}
+
+void PacketBuffer::append(ByteView bytes) {
+    uint8_t* out = append(bytes.size());
+    std::copy(bytes.begin(), bytes.end(), out);
+}
+
+std::vector<uint8_t> PacketBuffer::release() {
+    storage_.resize(tail_);
+    if (head_ > 0) {
+        storage_.erase(storage_.begin(), storage_.begin() + head_);
+    }
+    head_ = 0;
+    tail_ = 0;
+    return std::move(storage_);
+}
+
+} // namespace common
@@ -0,0 +1,178 @@
+#include "common/timing_wheel.h"
+#include <algorithm>
+
+namespace common {
+
+TimingWheel::TimingWheel(size_t maxTimers, uint64_t startTick)
+    : nodes_(maxTimers), current_(startTick), size_(0) {
+    for (auto& row : heads_) {
+        std::fill(std::begin(row), std::end(row), NONE);
+    }
+    std::fill(std::begin(occupied_), std::end(occupied_), 0);
+}
+
+void TimingWheel::link(uint32_t id, uint8_t level, uint8_t slot) {
+    Node& node = nodes_[id];
+    node.level = level;
+    node.slot = slot;
+    node.prev = NONE;
+    node.next = heads_[level][slot];
+    if (node.next != NONE) {
+        nodes_[node.next].prev = id;
+    }
+    heads_[level][slot] = id;
+    if (level < LEVELS) {
+        occupied_[level] |= 1ULL << slot;
+    }
+}
+
+void TimingWheel::unlink(uint32_t id) {
+    Node& node = nodes_[id];
+    if (node.prev != NONE) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.level][node.slot] = node.next;
+    }
+    if (node.next != NONE) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (node.level < LEVELS && heads_[node.level][node.slot] == NONE) {
+        occupied_[node.level] &= ~(1ULL << node.slot);
+    }
+    node.level = UNSCHEDULED;
+}
+
+void TimingWheel::place(uint32_t id) {
+    // 与当前刻度同属第k+1层的同一块时放入第k层，保证该槽位在本块内还会被访问到
+    uint64_t tick = nodes_[id].tick;
+    if (tick < current_) {
+        link(id, DUE, 0);
+        return;
+    }
+    for (uint8_t level = 0; level < LEVELS; ++level) {
+        unsigned shift = SLOT_BITS * (level + 1);
+        if ((tick >> shift) == (current_ >> shift)) {
+            link(id, level, static_cast<uint8_t>((tick >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            return;
+        }
+    }
+    link(id, OVERFLOW, 0);
+}
+
+void TimingWheel::schedule(uint32_t id, uint64_t tick) {
+    if (scheduled(id)) {
+        unlink(id);
+    } else {
+        ++size_;
+    }
+    nodes_[id].tick = tick;
+    place(id);
+}
+
+void TimingWheel::cancel(uint32_t id) {
+    if (scheduled(id)) {
+        unlink(id);
+        --size_;
+    }
+}
+
+void TimingWheel::cascade(uint8_t level, uint8_t slot) {
+    uint32_t id = heads_[level][slot];
+    heads_[level][slot] = NONE;
+    if (level < LEVELS) {
+        occupied_[level] &= ~(1ULL << slot);
+    }
+    while (id != NONE) {
+        uint32_t next = nodes_[id].next;
+        place(id);
+        id = next;
+    }
+}
+
+void TimingWheel::fire(uint8_t level, uint8_t slot, std::vector<uint32_t>& expired) {
+    uint32_t id = heads_[level][slot];
+    heads_[level][slot] = NONE;
+    if (level < LEVELS) {
+        occupied_[level] &= ~(1ULL << slot);
+    }
+    while (id != NONE) {
+        uint32_t next = nodes_[id].next;
+        nodes_[id].level = UNSCHEDULED;
+        --size_;
+        expired.push_back(id);
+        id = next;
+    }
+}
+
+void TimingWheel::advance(uint64_t nowTick, std::vector<uint32_t>& expired) {
+    fire(DUE, 0, expired);
+    
+    while (current_ <= nowTick && size_ > 0) {
+        uint8_t slot0 = static_cast<uint8_t>(current_ & (SLOTS - 1));
+        if (slot0 == 0) {
+            // 跨越块边界：先处理溢出表，再由高到低把当前块的定时器降到下层
+            if ((current_ & ((1ULL << (SLOT_BITS * LEVELS)) - 1)) == 0) {
+                cascade(OVERFLOW, 0);
+            }
+            for (uint8_t level = LEVELS - 1; level >= 1; --level) {
+                unsigned shift = SLOT_BITS * level;
+                if ((current_ & ((1ULL << shift) - 1)) == 0) {
+                    cascade(level, static_cast<uint8_t>((current_ >> shift) & (SLOTS - 1)));
+                }
+            }
+        }
+        
+        // 本块剩余槽位都为空时直接跳到下一块（或nowTick之后）
+        uint64_t pending = occupied_[0] >> slot0;
+        if (pending == 0) {
+            uint64_t blockEnd = (current_ | (SLOTS - 1)) + 1;
+            current_ = std::min(blockEnd, nowTick + 1);
+            continue;
+        }
+        uint64_t next = current_ + static_cast<uint64_t>(__builtin_ctzll(pending));
+        if (next > nowTick) {
+            current_ = nowTick + 1;
+            break;
+        }
+        current_ = next;
+        fire(0, static_cast<uint8_t>(current_ & (SLOTS - 1)), expired);
+        ++current_;
+    }
+    if (current_ <= nowTick) {
+        current_ = nowTick + 1;
+    }
+}
+
+uint64_t TimingWheel::nextTick() const {
+    if (size_ == 0) {
+        return UINT64_MAX;
+    }
+    if (heads_[DUE][0] != NONE) {
+        return current_;
+    }
+    uint8_t slot0 = static_cast<uint8_t>(current_ & (SLOTS - 1));
+    if (slot0 == 0) {
+        // 恰在块边界上时，本块的定时器可能还在高层等待下一次advance降层，
+        // 只能以当前刻度作为下界
+        if ((current_ & ((1ULL << (SLOT_BITS * LEVELS)) - 1)) == 0 && heads_[OVERFLOW][0] != NONE) {
+            return current_;
+        }
+        for (uint8_t level = 1; level < LEVELS; ++level) {
+            unsigned shift = SLOT_BITS * level;
+            if ((current_ & ((1ULL << shift) - 1)) != 0) {
+                break;
+            }
+            if (occupied_[level] & (1ULL << ((current_ >> shift) & (SLOTS - 1)))) {
+                return current_;
+            }
+        }
+    }
+    uint64_t pending = occupied_[0] >> slot0;
+    if (pending != 0) {
+        return current_ + static_cast<uint64_t>(__builtin_ctzll(pending));
+    }
+    // 更高层的定时器至少要到下一块才会到期
+    return (current_ | (SLOTS - 1)) + 1;
+}
+
+} // namespace common
@@ -0,0 +1,102 @@
+#include "common/toeplitz.h"
+#include "common/byte_view.h"
+
+namespace common {
+
+ToeplitzHash::ToeplitzHash() : ToeplitzHash(defaultKey()) {
+}
+
+ToeplitzHash::ToeplitzHash(const Key& key) : table_(TOEPLITZ_MAX_INPUT) {
+    // 输入第i字节第j位（自高位起）为1时，结果异或上密钥从第i*8+j位开始的32位窗口
+    auto window = [&key](size_t bit) {
+        uint32_t value = 0;
+        for (size_t k = 0; k < 32; ++k) {
+            size_t pos = bit + k;
+            uint32_t keyBit = (key[pos / 8] >> (7 - pos % 8)) & 1;
+            value = (value << 1) | keyBit;
+        }
+        return value;
+    };
+    
+    for (size_t i = 0; i < TOEPLITZ_MAX_INPUT; ++i) {
+        uint32_t windows[8];
+        for (size_t j = 0; j < 8; ++j) {
+            windows[j] = window(i * 8 + j);
+        }
+        for (size_t b = 0; b < 256; ++b) {
+            uint32_t value = 0;
+            for (size_t j = 0; j < 8; ++j) {
+                if (b & (0x80 >> j)) {
+                    value ^= windows[j];
+                }
+            }
+            table_[i][b] = value;
+        }
+    }
+}
+
+uint32_t ToeplitzHash::hash(const uint8_t* input, size_t len) const {
+    if (len > TOEPLITZ_MAX_INPUT) {
+        len = TOEPLITZ_MAX_INPUT;
+    }
+    uint32_t result = 0;
+    for (size_t i = 0; i < len; ++i) {
+        result ^= table_[i][input[i]];
+    }
+    return result;
+}
+
+uint32_t ToeplitzHash::hashIPv4(const uint8_t* srcIP, const uint8_t* dstIP,
+                                uint16_t srcPort, uint16_t dstPort) const {
+    uint8_t input[12];
+    for (size_t i = 0; i < 4; ++i) {
+        input[i] = srcIP[i];
+        input[4 + i] = dstIP[i];
+    }
+    storeBE16(input + 8, srcPort);
+    storeBE16(input + 10, dstPort);
+    return hash(input, sizeof(input));
+}
+
+uint32_t ToeplitzHash::hashIPv4(const uint8_t* srcIP, const uint8_t* dstIP) const {
+    uint8_t input[8];
+    for (size_t i = 0; i < 4; ++i) {
+        input[i] = srcIP[i];
+        input[4 + i] = dstIP[i];
+    }
+    return hash(input, sizeof(input));
+}
+
+uint32_t ToeplitzHash::hashIPv6(const uint8_t* srcIP, const uint8_t* dstIP,
+                                uint16_t srcPort, uint16_t dstPort) const {
+    uint8_t input[36];
+    for (size_t i = 0; i < 16; ++i) {
+        input[i] = srcIP[i];
+        input[16 + i] = dstIP[i];
+    }
+    storeBE16(input + 32, srcPort);
+    storeBE16(input + 34, dstPort);
+    return hash(input, sizeof(input));
+}
+
+uint32_t ToeplitzHash::hashIPv6(const uint8_t* srcIP, const uint8_t* dstIP) const {
+    uint8_t input[32];
+    for (size_t i = 0; i < 16; ++i) {
+        input[i] = srcIP[i];
+        input[16 + i] = dstIP[i];
+    }
+    return hash(input, sizeof(input));
+}
+
+const ToeplitzHash::Key& ToeplitzHash::defaultKey() {
+    static const Key key = {
+        0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+        0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+        0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+        0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+        0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+    };
+    return key;
+}
+
+} // namespace common
@@ -0,0 +1,64 @@
+#include "common/tsc_clock.h"
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace common {
+
+namespace {
+
+constexpr uint64_t CALIBRATION_NS = 20 * 1000 * 1000;
+
+bool hasInvariantTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx >> 8) & 1;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+const TscClock& TscClock::instance() {
+    static const TscClock clock;
+    return clock;
+}
+
+uint64_t TscClock::steadyNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+TscClock::TscClock() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (!hasInvariantTsc()) {
+        return;
+    }
+    
+    // 在约20ms内同时读取两个时钟，得到每个TSC周期对应的纳秒数
+    uint64_t startNs = steadyNs();
+    uint64_t startTicks = __rdtsc();
+    uint64_t endNs;
+    do {
+        endNs = steadyNs();
+    } while (endNs - startNs < CALIBRATION_NS);
+    uint64_t endTicks = __rdtsc();
+    if (endTicks <= startTicks) {
+        return;
+    }
+    
+    double nsPerTick = static_cast<double>(endNs - startNs) / static_cast<double>(endTicks - startTicks);
+    nsPerTick_ = static_cast<uint64_t>(nsPerTick * static_cast<double>(1ULL << FIXED_SHIFT));
+    ghz_ = 1.0 / nsPerTick;
+    baseTicks_ = endTicks;
+    baseNs_ = endNs;
+    useTsc_ = true;
+#endif
+}
+
+} // namespace common
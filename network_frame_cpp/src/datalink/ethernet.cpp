@@ -13,6 +13,14 @@ EthernetFrame::EthernetFrame(const MACAddress& srcMAC, const MACAddress& dstMAC,
     header_.etherType = etherType;
 }
 
+EthernetFrame::EthernetFrame(const EthernetView& view)
+    : header_(view.header()), payload_(view.payload()) {
+}
+
+EthernetFrame::EthernetFrame(const EthernetView& view, common::ByteStorage payload)
+    : header_(view.header()), payload_(std::move(payload)) {
+}
+
 EthernetFrame EthernetFrame::createIPv4(const MACAddress& srcMAC, const MACAddress& dstMAC,
                                          const std::vector<uint8_t>& payload) {
     return EthernetFrame(srcMAC, dstMAC, ETHERTYPE_IPV4, payload);
@@ -21,36 +29,55 @@ EthernetFrame EthernetFrame::createIPv4(const MACAddress& srcMAC, const MACAddre
 std::vector<uint8_t> EthernetFrame::encode() const {
     std::vector<uint8_t> buf(ETHERNET_HEADER_SIZE + payload_.size());
     
-    // 目的MAC地址
-    std::copy(header_.dstMAC.begin(), header_.dstMAC.end(), buf.begin());
-    // 源MAC地址
-    std::copy(header_.srcMAC.begin(), header_.srcMAC.end(), buf.begin() + 6);
-    // 类型字段
-    buf[12] = (header_.etherType >> 8) & 0xFF;
-    buf[13] = header_.etherType & 0xFF;
+    encodeHeader(header_, buf.data());
     // 数据
-    std::copy(payload_.begin(), payload_.end(), buf.begin() + ETHERNET_HEADER_SIZE);
+    common::ByteView payload = payload_.view();
+    std::copy(payload.begin(), payload.end(), buf.begin() + ETHERNET_HEADER_SIZE);
     
     return buf;
 }
 
-EthernetFrame EthernetFrame::decode(const std::vector<uint8_t>& data) {
-    if (data.size() < ETHERNET_HEADER_SIZE) {
-        throw std::runtime_error("Data too short for Ethernet header");
+void EthernetFrame::prependHeader(common::PacketBuffer& buf, const MACAddress& srcMAC,
+                                  const MACAddress& dstMAC, uint16_t etherType) {
+    EthernetHeader header;
+    header.dstMAC = dstMAC;
+    header.srcMAC = srcMAC;
+    header.etherType = etherType;
+    encodeHeader(header, buf.prepend(ETHERNET_HEADER_SIZE));
+}
+
+EthernetFrame EthernetFrame::decode(common::ByteView data) {
+    return EthernetFrame(EthernetView::parse(data));
+}
+
+common::DecodeStatus EthernetFrame::tryDecode(common::ByteView data, EthernetFrame& out) {
+    EthernetView view;
+    common::DecodeStatus status = EthernetView::tryParse(data, view);
+    if (status == common::DecodeStatus::Ok) {
+        out = EthernetFrame(view);
     }
-    
-    EthernetFrame frame;
-    std::copy(data.begin(), data.begin() + 6, frame.header_.dstMAC.begin());
-    std::copy(data.begin() + 6, data.begin() + 12, frame.header_.srcMAC.begin());
-    frame.header_.etherType = (static_cast<uint16_t>(data[12]) << 8) | data[13];
-    
-    frame.payload_.assign(data.begin() + ETHERNET_HEADER_SIZE, data.end());
-    
-    return frame;
+    return status;
+}
+
+EthernetView EthernetView::parse(common::ByteView frame) {
+    EthernetView view;
+    common::DecodeStatus status = tryParse(frame, view);
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
+    }
+    return view;
+}
+
+common::DecodeStatus EthernetView::tryParse(common::ByteView frame, EthernetView& out) noexcept {
+    if (frame.size() < ETHERNET_HEADER_SIZE) {
+        return common::DecodeStatus::EthernetTooShort;
+    }
+    out = EthernetView(frame);
+    return common::DecodeStatus::Ok;
 }
 
 std::vector<uint8_t> EthernetFrame::getPayload() const {
-    return payload_;
+    return payload_.toVector();
 }
 
 EthernetHeader EthernetFrame::getHeader() const {
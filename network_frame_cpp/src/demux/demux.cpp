@@ -0,0 +1,209 @@
+#include "demux/demux.h"
+#include "datalink/ethernet.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "transport/udp.h"
+#include "transport/tcp.h"
+#include <stdexcept>
+
+namespace demux {
+
+namespace {
+
+constexpr size_t ARP_MIN_SIZE = 28;
+constexpr size_t ICMP_MIN_SIZE = 4;
+constexpr uint8_t MAX_VLAN_TAGS = 2;
+
+} // namespace
+
+Demux::Demux() : etherSlots_(65536, 0), etherEntries_(1), protocolEntries_(256) {
+    etherEntry(datalink::ETHERTYPE_IPV4) = Entry{&Demux::decodeIPv4, &DemuxStats::ipv4, nullptr};
+    etherEntry(datalink::ETHERTYPE_IPV6) = Entry{&Demux::decodeIPv6, &DemuxStats::ipv6, nullptr};
+    etherEntry(datalink::ETHERTYPE_ARP) = Entry{&Demux::decodeArp, &DemuxStats::arp, nullptr};
+    etherEntry(datalink::ETHERTYPE_VLAN) = Entry{&Demux::decodeVlan, &DemuxStats::vlan, nullptr};
+    etherEntry(datalink::ETHERTYPE_QINQ) = Entry{&Demux::decodeVlan, &DemuxStats::vlan, nullptr};
+    
+    protocolEntries_[network::PROTOCOL_UDP] = Entry{&Demux::decodePorts, &DemuxStats::udp, nullptr};
+    protocolEntries_[network::PROTOCOL_TCP] = Entry{&Demux::decodeTcp, &DemuxStats::tcp, nullptr};
+    protocolEntries_[network::PROTOCOL_ICMP] = Entry{&Demux::decodeIcmp, &DemuxStats::icmp, nullptr};
+    protocolEntries_[network::PROTOCOL_ICMPV6] = Entry{&Demux::decodeIcmp, &DemuxStats::icmp, nullptr};
+}
+
+Demux::Entry& Demux::etherEntry(uint16_t etherType) {
+    uint8_t& slot = etherSlots_[etherType];
+    if (slot == 0) {
+        if (etherEntries_.size() > UINT8_MAX) {
+            throw std::runtime_error("Too many registered EtherTypes");
+        }
+        slot = static_cast<uint8_t>(etherEntries_.size());
+        etherEntries_.emplace_back();
+    }
+    return etherEntries_[slot];
+}
+
+void Demux::onEtherType(uint16_t etherType, Handler handler) {
+    Entry& entry = etherEntry(etherType);
+    if (!entry.counter) {
+        entry.counter = &DemuxStats::other;
+    }
+    entry.handler = std::move(handler);
+}
+
+void Demux::onProtocol(uint8_t protocol, Handler handler) {
+    Entry& entry = protocolEntries_[protocol];
+    if (!entry.counter) {
+        entry.counter = &DemuxStats::other;
+    }
+    entry.handler = std::move(handler);
+}
+
+Result Demux::process(common::ByteView frame, Packet& packet) {
+    packet = Packet();
+    packet.frame = frame;
+    ++stats_.frames;
+    if (frame.size() < datalink::ETHERNET_HEADER_SIZE) {
+        ++stats_.malformed;
+        return Result::Malformed;
+    }
+    Result result = dispatchEtherType(packet, datalink::fields::EtherType::get(frame.data()),
+                                      datalink::ETHERNET_HEADER_SIZE);
+    if (result == Result::Malformed) {
+        ++stats_.malformed;
+    }
+    return result;
+}
+
+Result Demux::dispatchEtherType(Packet& packet, uint16_t etherType, size_t offset) {
+    packet.etherType = etherType;
+    packet.networkOffset = static_cast<uint16_t>(offset);
+    uint8_t slot = etherSlots_[etherType];
+    if (slot == 0) {
+        ++stats_.unknownEtherType;
+        return Result::UnknownEtherType;
+    }
+    
+    const Entry& entry = etherEntries_[slot];
+    ++(stats_.*entry.counter);
+    Result result = entry.decode ? (this->*entry.decode)(packet) : Result::Ok;
+    if (result == Result::Ok && entry.handler) {
+        entry.handler(packet);
+    }
+    return result;
+}
+
+Result Demux::dispatchProtocol(Packet& packet) {
+    const Entry& entry = protocolEntries_[packet.protocol];
+    if (!entry.counter) {
+        ++stats_.unknownProtocol;
+        return Result::UnknownProtocol;
+    }
+    
+    ++(stats_.*entry.counter);
+    Result result = entry.decode ? (this->*entry.decode)(packet) : Result::Ok;
+    if (result == Result::Ok && entry.handler) {
+        entry.handler(packet);
+    }
+    return result;
+}
+
+Result Demux::decodeVlan(Packet& packet) {
+    // 标签控制信息的低12位为VLAN标识，其后是内层以太网类型
+    size_t offset = packet.networkOffset;
+    if (packet.vlanTags >= MAX_VLAN_TAGS || packet.frame.size() < offset + datalink::VLAN_TAG_SIZE) {
+        return Result::Malformed;
+    }
+    const uint8_t* tag = packet.frame.data() + offset;
+    if (packet.vlanTags++ == 0) {
+        packet.vlanId = common::loadBE16(tag) & 0x0FFF;
+    }
+    return dispatchEtherType(packet, common::loadBE16(tag + 2), offset + datalink::VLAN_TAG_SIZE);
+}
+
+Result Demux::decodeArp(Packet& packet) {
+    return packet.frame.size() >= packet.networkOffset + ARP_MIN_SIZE ? Result::Ok : Result::Malformed;
+}
+
+Result Demux::decodeIPv4(Packet& packet) {
+    common::ByteView ip = packet.network();
+    if (ip.size() < network::IPV4_HEADER_SIZE || network::fields::Version::get(ip.data()) != 4) {
+        return Result::Malformed;
+    }
+    size_t headerLength = static_cast<size_t>(network::fields::Ihl::get(ip.data())) * 4;
+    size_t totalLength = network::fields::TotalLength::get(ip.data());
+    if (headerLength < network::IPV4_HEADER_SIZE || totalLength < headerLength || totalLength > ip.size()) {
+        return Result::Malformed;
+    }
+    
+    packet.ipVersion = 4;
+    packet.protocol = network::fields::Protocol::get(ip.data());
+    // 非首片不含传输层首部
+    if (network::fields::FragmentOffset::get(ip.data()) != 0) {
+        packet.fragment = true;
+        return Result::Ok;
+    }
+    packet.transportOffset = static_cast<uint16_t>(packet.networkOffset + headerLength);
+    return dispatchProtocol(packet);
+}
+
+Result Demux::decodeIPv6(Packet& packet) {
+    network::IPv6View ip;
+    network::IPv6Extensions extensions;
+    if (network::IPv6View::tryParse(packet.network(), ip) != common::DecodeStatus::Ok ||
+        ip.walkExtensions(extensions) != common::DecodeStatus::Ok) {
+        return Result::Malformed;
+    }
+    
+    packet.ipVersion = 6;
+    packet.protocol = extensions.protocol;
+    // 与IPv4相同：非首片不含传输层首部
+    if (extensions.fragment && extensions.fragmentOffset != 0) {
+        packet.fragment = true;
+        return Result::Ok;
+    }
+    packet.transportOffset = static_cast<uint16_t>(packet.networkOffset + extensions.offset);
+    return dispatchProtocol(packet);
+}
+
+Result Demux::decodePorts(Packet& packet) {
+    common::ByteView l4 = packet.transport();
+    if (l4.size() < transport::UDP_HEADER_SIZE) {
+        return Result::Malformed;
+    }
+    packet.srcPort = transport::fields::SrcPort::get(l4.data());
+    packet.dstPort = transport::fields::DstPort::get(l4.data());
+    return Result::Ok;
+}
+
+Result Demux::decodeTcp(Packet& packet) {
+    // 数据偏移（首部长度）至少为5个32位字
+    common::ByteView l4 = packet.transport();
+    if (l4.size() < transport::TCP_HEADER_SIZE ||
+        transport::fields::DataOffset::get(l4.data()) < transport::TCP_HEADER_SIZE / 4) {
+        return Result::Malformed;
+    }
+    packet.srcPort = transport::fields::SrcPort::get(l4.data());
+    packet.dstPort = transport::fields::DstPort::get(l4.data());
+    return Result::Ok;
+}
+
+Result Demux::decodeIcmp(Packet& packet) {
+    common::ByteView l4 = packet.transport();
+    if (l4.size() < ICMP_MIN_SIZE) {
+        return Result::Malformed;
+    }
+    packet.icmpType = l4[0];
+    packet.icmpCode = l4[1];
+    return Result::Ok;
+}
+
+const char* resultName(Result result) {
+    switch (result) {
+        case Result::Ok: return "ok";
+        case Result::UnknownEtherType: return "unknown EtherType";
+        case Result::UnknownProtocol: return "unknown IP protocol";
+        case Result::Malformed: return "malformed";
+    }
+    return "unknown";
+}
+
+} // namespace demux
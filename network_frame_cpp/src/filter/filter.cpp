@@ -0,0 +1,553 @@
+#include "filter/filter.h"
+#include "network/ipv6.h"
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace filter {
+
+namespace {
+
+constexpr size_t ETHER_HEADER = 14;
+constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+constexpr uint8_t PROTO_TCP = 6;
+constexpr uint8_t PROTO_UDP = 17;
+
+// 表达式语法树节点
+struct Node {
+    enum Kind { TEST, AND, OR, NOT } kind;
+    Instruction test;
+    int left;
+    int right;
+};
+
+enum class Direction { ANY, SRC, DST };
+
+std::runtime_error syntaxError(const std::string& message, const std::string& token) {
+    return std::runtime_error("Invalid filter expression: " + message +
+                              (token.empty() ? " at end of input" : " at '" + token + "'"));
+}
+
+std::vector<std::string> tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (c == '(' || c == ')') {
+            tokens.emplace_back(1, c);
+            ++i;
+        } else if (c == '&' || c == '|' || c == '!' || c == '<' || c == '>' || c == '=') {
+            // 运算符：&& || ! != < <= > >= = ==
+            size_t len = 1;
+            if (i + 1 < text.size() &&
+                ((c == '&' && text[i + 1] == '&') || (c == '|' && text[i + 1] == '|') ||
+                 (c != '&' && c != '|' && text[i + 1] == '='))) {
+                len = 2;
+            }
+            tokens.push_back(text.substr(i, len));
+            i += len;
+        } else {
+            size_t start = i;
+            while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])) &&
+                   std::string("()&|!<>=").find(text[i]) == std::string::npos) {
+                ++i;
+            }
+            std::string word = text.substr(start, i - start);
+            for (auto& ch : word) {
+                ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+            }
+            tokens.push_back(word);
+        }
+    }
+    return tokens;
+}
+
+uint32_t parseNumber(const std::string& token, uint32_t max) {
+    if (token.empty() || !std::isdigit(static_cast<unsigned char>(token[0]))) {
+        throw syntaxError("expected a number", token);
+    }
+    size_t used = 0;
+    unsigned long value;
+    try {
+        value = std::stoul(token, &used, 0);
+    } catch (const std::exception&) {
+        throw syntaxError("expected a number", token);
+    }
+    if (used != token.size() || value > max) {
+        throw syntaxError("number out of range", token);
+    }
+    return static_cast<uint32_t>(value);
+}
+
+bool isAddress(const std::string& token) {
+    return !token.empty() && std::isdigit(static_cast<unsigned char>(token[0])) &&
+           token.find('.') != std::string::npos;
+}
+
+uint32_t parseAddress(const std::string& token) {
+    uint32_t address = 0;
+    int parts = 0;
+    std::istringstream in(token);
+    std::string part;
+    while (std::getline(in, part, '.')) {
+        address = (address << 8) | parseNumber(part, 255);
+        ++parts;
+    }
+    if (parts != 4) {
+        throw syntaxError("expected an IPv4 address", token);
+    }
+    return address;
+}
+
+class Parser {
+public:
+    explicit Parser(const std::string& text) : tokens_(tokenize(text)), pos_(0) {}
+
+    std::vector<Node> nodes;
+
+    int parse() {
+        int root = parseOr();
+        if (pos_ != tokens_.size()) {
+            throw syntaxError("unexpected token", tokens_[pos_]);
+        }
+        return root;
+    }
+
+private:
+    std::vector<std::string> tokens_;
+    size_t pos_;
+
+    const std::string& peek() const {
+        static const std::string end;
+        return pos_ < tokens_.size() ? tokens_[pos_] : end;
+    }
+
+    std::string take() {
+        return pos_ < tokens_.size() ? tokens_[pos_++] : std::string();
+    }
+
+    int add(Node::Kind kind, int left, int right) {
+        nodes.push_back(Node{kind, Instruction{}, left, right});
+        return static_cast<int>(nodes.size() - 1);
+    }
+
+    int test(Instruction::Op op, uint32_t value, uint32_t mask = 0, Instruction::Cmp cmp = Instruction::EQ) {
+        Node node{Node::TEST, Instruction{}, -1, -1};
+        node.test.op = op;
+        node.test.cmp = cmp;
+        node.test.value = value;
+        node.test.mask = mask;
+        nodes.push_back(node);
+        return static_cast<int>(nodes.size() - 1);
+    }
+
+    int parseOr() {
+        int left = parseAnd();
+        while (peek() == "or" || peek() == "||") {
+            take();
+            left = add(Node::OR, left, parseAnd());
+        }
+        return left;
+    }
+
+    int parseAnd() {
+        int left = parseNot();
+        while (peek() == "and" || peek() == "&&") {
+            take();
+            left = add(Node::AND, left, parseNot());
+        }
+        return left;
+    }
+
+    int parseNot() {
+        if (peek() == "not" || peek() == "!") {
+            take();
+            return add(Node::NOT, parseNot(), -1);
+        }
+        return parsePrimary();
+    }
+
+    static bool startsQualifiedTerm(const std::string& token) {
+        return token == "src" || token == "dst" || token == "host" || token == "net" ||
+               token == "port" || token == "portrange";
+    }
+
+    int parsePrimary() {
+        std::string token = take();
+        if (token == "(") {
+            int inner = parseOr();
+            if (peek() != ")") {
+                throw syntaxError("expected ')'", peek());
+            }
+            take();
+            return inner;
+        }
+        
+        int protocol = -1;
+        if (token == "ip") {
+            protocol = test(Instruction::ETHER_TYPE, ETHERTYPE_IPV4);
+        } else if (token == "ip6") {
+            protocol = test(Instruction::ETHER_TYPE, ETHERTYPE_IPV6);
+        } else if (token == "arp") {
+            protocol = test(Instruction::ETHER_TYPE, 0x0806);
+        } else if (token == "vlan") {
+            protocol = test(Instruction::ETHER_TYPE, 0x8100);
+        } else if (token == "udp") {
+            protocol = test(Instruction::IP_PROTO, PROTO_UDP);
+        } else if (token == "tcp") {
+            protocol = test(Instruction::IP_PROTO, PROTO_TCP);
+        } else if (token == "icmp") {
+            protocol = test(Instruction::IP_PROTO, 1);
+        }
+        if (protocol >= 0) {
+            // 协议限定词后直接跟地址/端口条件时按and连接（udp port 80）
+            if (token != "ip" || peek() != "proto") {
+                if (startsQualifiedTerm(peek())) {
+                    return add(Node::AND, protocol, parseTerm(take()));
+                }
+                return protocol;
+            }
+            token = take();
+        }
+        return parseTerm(token);
+    }
+
+    int parseTerm(const std::string& token) {
+        if (token == "proto") {
+            return test(Instruction::IP_PROTO, parseNumber(take(), 255));
+        }
+        if (token == "len") {
+            std::string op = take();
+            Instruction::Cmp cmp;
+            if (op == "==" || op == "=") {
+                cmp = Instruction::EQ;
+            } else if (op == "!=") {
+                cmp = Instruction::NE;
+            } else if (op == "<") {
+                cmp = Instruction::LT;
+            } else if (op == "<=") {
+                cmp = Instruction::LE;
+            } else if (op == ">") {
+                cmp = Instruction::GT;
+            } else if (op == ">=") {
+                cmp = Instruction::GE;
+            } else {
+                throw syntaxError("expected a comparison operator", op);
+            }
+            return test(Instruction::FRAME_LEN, parseNumber(take(), 0xFFFFFFFF), 0, cmp);
+        }
+        if (token == "greater") {
+            return test(Instruction::FRAME_LEN, parseNumber(take(), 0xFFFFFFFF), 0, Instruction::GE);
+        }
+        if (token == "less") {
+            return test(Instruction::FRAME_LEN, parseNumber(take(), 0xFFFFFFFF), 0, Instruction::LE);
+        }
+        
+        Direction dir = Direction::ANY;
+        std::string kind = token;
+        if (token == "src" || token == "dst") {
+            dir = token == "src" ? Direction::SRC : Direction::DST;
+            // src 10.0.0.1 / src 10.0.0.0/8 省略host/net
+            if (isAddress(peek())) {
+                kind = peek().find('/') == std::string::npos ? "host" : "net";
+            } else {
+                kind = take();
+            }
+        }
+        
+        if (kind == "host" || kind == "net") {
+            std::string arg = take();
+            uint32_t prefix = 32;
+            size_t slash = arg.find('/');
+            if (slash != std::string::npos) {
+                if (kind == "host") {
+                    throw syntaxError("host takes a single address", arg);
+                }
+                prefix = parseNumber(arg.substr(slash + 1), 32);
+                arg = arg.substr(0, slash);
+            }
+            uint32_t mask = prefix == 0 ? 0 : 0xFFFFFFFFu << (32 - prefix);
+            uint32_t address = parseAddress(arg) & mask;
+            return directional(dir, Instruction::IP_SRC, Instruction::IP_DST, address, mask);
+        }
+        if (kind == "port") {
+            uint32_t port = parseNumber(take(), 0xFFFF);
+            return directional(dir, Instruction::SRC_PORT, Instruction::DST_PORT, port, port);
+        }
+        if (kind == "portrange") {
+            std::string arg = take();
+            size_t dash = arg.find('-');
+            if (dash == std::string::npos) {
+                throw syntaxError("expected a port range N-M", arg);
+            }
+            uint32_t low = parseNumber(arg.substr(0, dash), 0xFFFF);
+            uint32_t high = parseNumber(arg.substr(dash + 1), 0xFFFF);
+            if (low > high) {
+                throw syntaxError("empty port range", arg);
+            }
+            return directional(dir, Instruction::SRC_PORT, Instruction::DST_PORT, low, high);
+        }
+        throw syntaxError("unknown primitive", kind);
+    }
+
+    int directional(Direction dir, Instruction::Op srcOp, Instruction::Op dstOp, uint32_t value, uint32_t mask) {
+        if (dir == Direction::SRC) {
+            return test(srcOp, value, mask);
+        }
+        if (dir == Direction::DST) {
+            return test(dstOp, value, mask);
+        }
+        int src = test(srcOp, value, mask);
+        return add(Node::OR, src, test(dstOp, value, mask));
+    }
+};
+
+// 把语法树编译为跳转代码：先生成带符号标签的指令，最后解析为指令下标
+class Compiler {
+public:
+    explicit Compiler(const std::vector<Node>& nodes) : nodes_(nodes) {}
+
+    std::vector<Instruction> compile(int root) {
+        emit(root, ACCEPT_LABEL, REJECT_LABEL);
+        for (auto& insn : code_) {
+            insn.jt = resolve(insn.jt);
+            insn.jf = resolve(insn.jf);
+        }
+        return code_;
+    }
+
+private:
+    static constexpr uint16_t ACCEPT_LABEL = 0xFFFF;
+    static constexpr uint16_t REJECT_LABEL = 0xFFFE;
+
+    const std::vector<Node>& nodes_;
+    std::vector<Instruction> code_;
+    std::vector<size_t> labels_;   // 标签 -> 指令下标
+
+    uint16_t newLabel() {
+        if (labels_.size() >= REJECT_LABEL) {
+            throw std::runtime_error("Invalid filter expression: too complex");
+        }
+        labels_.push_back(0);
+        return static_cast<uint16_t>(labels_.size() - 1);
+    }
+
+    void place(uint16_t label) {
+        labels_[label] = code_.size();
+    }
+
+    uint16_t resolve(uint16_t label) const {
+        if (label >= REJECT_LABEL) {
+            return label == ACCEPT_LABEL ? Instruction::ACCEPT : Instruction::REJECT;
+        }
+        return static_cast<uint16_t>(labels_[label]);
+    }
+
+    void emit(int index, uint16_t onTrue, uint16_t onFalse) {
+        const Node& node = nodes_[index];
+        switch (node.kind) {
+        case Node::TEST: {
+            if (code_.size() >= Instruction::REJECT) {
+                throw std::runtime_error("Invalid filter expression: too complex");
+            }
+            Instruction insn = node.test;
+            insn.jt = onTrue;
+            insn.jf = onFalse;
+            code_.push_back(insn);
+            break;
+        }
+        case Node::AND: {
+            uint16_t right = newLabel();
+            emit(node.left, right, onFalse);
+            place(right);
+            emit(node.right, onTrue, onFalse);
+            break;
+        }
+        case Node::OR: {
+            uint16_t right = newLabel();
+            emit(node.left, onTrue, right);
+            place(right);
+            emit(node.right, onTrue, onFalse);
+            break;
+        }
+        case Node::NOT:
+            emit(node.left, onFalse, onTrue);
+            break;
+        }
+    }
+};
+
+// IPv4首部（不是IPv4或首部不完整时返回nullptr）
+inline const uint8_t* ipv4Header(common::ByteView frame) {
+    if (frame.size() < ETHER_HEADER + 20 || common::loadBE16(frame.data() + 12) != ETHERTYPE_IPV4) {
+        return nullptr;
+    }
+    const uint8_t* ip = frame.data() + ETHER_HEADER;
+    if ((ip[0] >> 4) != 4 || (ip[0] & 0x0F) < 5) {
+        return nullptr;
+    }
+    return ip;
+}
+
+// IP载荷的上层协议与上层首部在帧内的偏移（IPv4或IPv6，后者跳过扩展首部）；
+// firstFragment为假表示非首个分片，上层首部不在本帧中
+struct UpperLayer {
+    uint8_t protocol;
+    size_t offset;
+    bool firstFragment;
+};
+
+inline bool upperLayer(common::ByteView frame, UpperLayer& out) {
+    if (const uint8_t* ip = ipv4Header(frame)) {
+        out.protocol = ip[9];
+        out.offset = ETHER_HEADER + static_cast<size_t>(ip[0] & 0x0F) * 4;
+        out.firstFragment = (common::loadBE16(ip + 6) & 0x1FFF) == 0;
+        return true;
+    }
+    if (frame.size() < ETHER_HEADER || common::loadBE16(frame.data() + 12) != ETHERTYPE_IPV6) {
+        return false;
+    }
+    network::IPv6View ip;
+    network::IPv6Extensions extensions;
+    if (network::IPv6View::tryParse(frame.subview(ETHER_HEADER), ip) != common::DecodeStatus::Ok ||
+        ip.walkExtensions(extensions) != common::DecodeStatus::Ok) {
+        return false;
+    }
+    out.protocol = extensions.protocol;
+    out.offset = ETHER_HEADER + extensions.offset;
+    out.firstFragment = !extensions.fragment || extensions.fragmentOffset == 0;
+    return true;
+}
+
+// UDP/TCP端口所在位置（非首个分片或长度不足时返回nullptr）
+inline const uint8_t* transportHeader(common::ByteView frame) {
+    UpperLayer layer;
+    if (!upperLayer(frame, layer) || (layer.protocol != PROTO_UDP && layer.protocol != PROTO_TCP) ||
+        !layer.firstFragment) {
+        return nullptr;
+    }
+    return frame.size() >= layer.offset + 4 ? frame.data() + layer.offset : nullptr;
+}
+
+inline bool compare(Instruction::Cmp cmp, uint32_t lhs, uint32_t rhs) {
+    switch (cmp) {
+    case Instruction::EQ: return lhs == rhs;
+    case Instruction::NE: return lhs != rhs;
+    case Instruction::LT: return lhs < rhs;
+    case Instruction::LE: return lhs <= rhs;
+    case Instruction::GT: return lhs > rhs;
+    case Instruction::GE: return lhs >= rhs;
+    }
+    return false;
+}
+
+inline bool evaluate(const Instruction& insn, common::ByteView frame) {
+    switch (insn.op) {
+    case Instruction::ETHER_TYPE:
+        return frame.size() >= ETHER_HEADER && common::loadBE16(frame.data() + 12) == insn.value;
+    case Instruction::IP_PROTO: {
+        UpperLayer layer;
+        return upperLayer(frame, layer) && layer.protocol == insn.value;
+    }
+    case Instruction::IP_SRC:
+    case Instruction::IP_DST: {
+        const uint8_t* ip = ipv4Header(frame);
+        size_t offset = insn.op == Instruction::IP_SRC ? 12 : 16;
+        return ip && (common::loadBE32(ip + offset) & insn.mask) == insn.value;
+    }
+    case Instruction::SRC_PORT:
+    case Instruction::DST_PORT: {
+        const uint8_t* l4 = transportHeader(frame);
+        if (!l4) {
+            return false;
+        }
+        uint16_t port = common::loadBE16(l4 + (insn.op == Instruction::SRC_PORT ? 0 : 2));
+        return port >= insn.value && port <= insn.mask;
+    }
+    case Instruction::FRAME_LEN:
+        return compare(insn.cmp, static_cast<uint32_t>(frame.size()), insn.value);
+    }
+    return false;
+}
+
+std::string formatAddress(uint32_t address) {
+    return std::to_string(address >> 24) + "." + std::to_string((address >> 16) & 0xFF) + "." +
+           std::to_string((address >> 8) & 0xFF) + "." + std::to_string(address & 0xFF);
+}
+
+std::string formatTarget(uint16_t target) {
+    if (target == Instruction::ACCEPT) {
+        return "accept";
+    }
+    if (target == Instruction::REJECT) {
+        return "reject";
+    }
+    return std::to_string(target);
+}
+
+} // namespace
+
+Filter Filter::compile(const std::string& expression) {
+    Filter filter;
+    filter.expression_ = expression;
+    if (tokenize(expression).empty()) {
+        return filter;
+    }
+    Parser parser(expression);
+    int root = parser.parse();
+    filter.program_ = Compiler(parser.nodes).compile(root);
+    return filter;
+}
+
+bool Filter::run(common::ByteView frame) const {
+    const Instruction* code = program_.data();
+    uint16_t pc = 0;
+    for (;;) {
+        const Instruction& insn = code[pc];
+        uint16_t next = evaluate(insn, frame) ? insn.jt : insn.jf;
+        if (next >= Instruction::REJECT) {
+            return next == Instruction::ACCEPT;
+        }
+        pc = next;
+    }
+}
+
+std::string Filter::dump() const {
+    static const char* const CMP_NAMES[] = {"==", "!=", "<", "<=", ">", ">="};
+    std::ostringstream out;
+    if (program_.empty()) {
+        out << "  accept all" << std::endl;
+    }
+    for (size_t i = 0; i < program_.size(); ++i) {
+        const Instruction& insn = program_[i];
+        out << "  " << i << ": ";
+        switch (insn.op) {
+        case Instruction::ETHER_TYPE:
+            out << "ether.type == 0x" << std::hex << insn.value << std::dec;
+            break;
+        case Instruction::IP_PROTO:
+            out << "ip.proto == " << insn.value;
+            break;
+        case Instruction::IP_SRC:
+        case Instruction::IP_DST:
+            out << (insn.op == Instruction::IP_SRC ? "ip.src" : "ip.dst") << " & "
+                << formatAddress(insn.mask) << " == " << formatAddress(insn.value);
+            break;
+        case Instruction::SRC_PORT:
+        case Instruction::DST_PORT:
+            out << (insn.op == Instruction::SRC_PORT ? "src.port" : "dst.port") << " in ["
+                << insn.value << ", " << insn.mask << "]";
+            break;
+        case Instruction::FRAME_LEN:
+            out << "len " << CMP_NAMES[insn.cmp] << " " << insn.value;
+            break;
+        }
+        out << "  jt " << formatTarget(insn.jt) << " jf " << formatTarget(insn.jf) << std::endl;
+    }
+    return out.str();
+}
+
+} // namespace filter
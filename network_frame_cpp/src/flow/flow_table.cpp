@@ -0,0 +1,178 @@
+#include "flow/flow_table.h"
+#include "common/hash.h"
+#include <stdexcept>
+
+namespace flow {
+
+FlowKey FlowKey::fromHeaders(const network::IPv4Header& ipv4, const transport::UDPHeader& udp) {
+    FlowKey key;
+    key.srcIP = common::loadBE32(ipv4.srcIP.data());
+    key.dstIP = common::loadBE32(ipv4.dstIP.data());
+    key.srcPort = udp.srcPort;
+    key.dstPort = udp.dstPort;
+    key.protocol = ipv4.protocol;
+    return key;
+}
+
+FlowKey FlowKey::fromView(const network::IPv4View& ipv4, const transport::UDPView& udp) {
+    FlowKey key;
+    const uint8_t* ip = ipv4.bytes().data();
+    key.srcIP = common::loadBE32(ip + 12);
+    key.dstIP = common::loadBE32(ip + 16);
+    key.srcPort = udp.srcPort();
+    key.dstPort = udp.dstPort();
+    key.protocol = ipv4.protocol();
+    return key;
+}
+
+FlowExporter::FlowExporter(std::ostream& out, size_t batchSize)
+    : out_(out), batchSize_(batchSize == 0 || batchSize > 0xFFFF ? 256 : batchSize),
+      buffer_(FLOW_BATCH_HEADER_SIZE + batchSize_ * FLOW_RECORD_SIZE), count_(0), exportNs_(0),
+      records_(0), batches_(0) {}
+
+FlowExporter::~FlowExporter() {
+    flush();
+}
+
+void FlowExporter::add(const FlowRecord& record, uint64_t nowNs) {
+    uint8_t* p = buffer_.data() + FLOW_BATCH_HEADER_SIZE + count_ * FLOW_RECORD_SIZE;
+    common::storeBE32(p, record.key.srcIP);
+    common::storeBE32(p + 4, record.key.dstIP);
+    common::storeLE16(p + 8, record.key.srcPort);
+    common::storeLE16(p + 10, record.key.dstPort);
+    p[12] = record.key.protocol;
+    p[13] = p[14] = p[15] = 0;
+    common::storeLE64(p + 16, record.packets);
+    common::storeLE64(p + 24, record.bytes);
+    common::storeLE64(p + 32, record.firstSeenNs);
+    common::storeLE64(p + 40, record.lastSeenNs);
+    
+    exportNs_ = nowNs;
+    ++records_;
+    if (++count_ == batchSize_) {
+        flush();
+    }
+}
+
+void FlowExporter::flush() {
+    if (count_ == 0) {
+        return;
+    }
+    uint8_t* header = buffer_.data();
+    common::storeLE32(header, FLOW_EXPORT_MAGIC);
+    common::storeLE16(header + 4, FLOW_EXPORT_VERSION);
+    common::storeLE16(header + 6, static_cast<uint16_t>(count_));
+    common::storeLE64(header + 8, exportNs_);
+    out_.write(reinterpret_cast<const char*>(header), FLOW_BATCH_HEADER_SIZE + count_ * FLOW_RECORD_SIZE);
+    count_ = 0;
+    ++batches_;
+}
+
+FlowTable::FlowTable(const FlowTableConfig& config) : config_(config), mask_(0), size_(0) {
+    if (config_.maxFlows == 0) {
+        throw std::runtime_error("Flow table capacity must be positive");
+    }
+    size_t tableSize = 2;
+    while (tableSize < config_.maxFlows * 2) {
+        tableSize <<= 1;
+    }
+    table_.resize(tableSize);
+    mask_ = tableSize - 1;
+}
+
+size_t FlowTable::slotFor(const FlowKey& key) const {
+    uint64_t h = (static_cast<uint64_t>(key.srcIP) << 32) | key.dstIP;
+    h ^= common::mix64((static_cast<uint64_t>(key.srcPort) << 24) |
+                       (static_cast<uint64_t>(key.dstPort) << 8) | key.protocol);
+    return static_cast<size_t>(common::mix64(h)) & mask_;
+}
+
+const FlowRecord* FlowTable::update(const FlowKey& key, size_t bytes, uint64_t nowNs) {
+    ++stats_.packets;
+    size_t i = slotFor(key);
+    while (table_[i].packets != 0) {
+        FlowRecord& record = table_[i];
+        if (record.key == key) {
+            ++record.packets;
+            record.bytes += bytes;
+            record.lastSeenNs = nowNs;
+            return &record;
+        }
+        i = (i + 1) & mask_;
+    }
+    
+    if (size_ == config_.maxFlows) {
+        ++stats_.dropped;
+        return nullptr;
+    }
+    FlowRecord& record = table_[i];
+    record.key = key;
+    record.packets = 1;
+    record.bytes = bytes;
+    record.firstSeenNs = nowNs;
+    record.lastSeenNs = nowNs;
+    ++size_;
+    ++stats_.created;
+    return &record;
+}
+
+const FlowRecord* FlowTable::find(const FlowKey& key) const {
+    for (size_t i = slotFor(key); table_[i].packets != 0; i = (i + 1) & mask_) {
+        if (table_[i].key == key) {
+            return &table_[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t FlowTable::expire(uint64_t nowNs, FlowExporter* exporter) {
+    // 删除时后续记录可能前移到当前位置，因此删除后不前进
+    size_t removed = 0;
+    for (size_t i = 0; i < table_.size() && size_ > 0;) {
+        const FlowRecord& record = table_[i];
+        if (record.packets != 0 && nowNs - record.lastSeenNs >= config_.idleTimeoutNs) {
+            if (exporter) {
+                exporter->add(record, nowNs);
+            }
+            erase(i);
+            ++removed;
+            continue;
+        }
+        ++i;
+    }
+    stats_.expired += removed;
+    return removed;
+}
+
+size_t FlowTable::flush(uint64_t nowNs, FlowExporter* exporter) {
+    size_t removed = size_;
+    for (auto& record : table_) {
+        if (record.packets != 0) {
+            if (exporter) {
+                exporter->add(record, nowNs);
+            }
+            record.packets = 0;
+        }
+    }
+    size_ = 0;
+    return removed;
+}
+
+void FlowTable::erase(size_t index) {
+    // 后移删除：把探测链上不能越过空位的记录前移，保持线性探测不中断
+    size_t hole = index;
+    table_[hole].packets = 0;
+    for (size_t j = (hole + 1) & mask_; table_[j].packets != 0; j = (j + 1) & mask_) {
+        size_t ideal = slotFor(table_[j].key);
+        bool stays = (hole <= j) ? (hole < ideal && ideal <= j) : (hole < ideal || ideal <= j);
+        if (stays) {
+            continue;
+        }
+        table_[hole] = table_[j];
+        table_[j].packets = 0;
+        hole = j;
+    }
+    --size_;
+}
+
+} // namespace flow
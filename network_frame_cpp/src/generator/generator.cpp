@@ -0,0 +1,224 @@
+#include "generator/generator.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace generator {
+
+namespace {
+
+constexpr size_t MAX_PAYLOAD = 9000;
+
+// IMIX线上帧长（含以太网首部与FCS）与权重
+constexpr size_t IMIX_FRAMES[] = {64, 594, 1518};
+constexpr uint32_t IMIX_WEIGHTS[] = {7, 4, 1};
+constexpr uint32_t IMIX_TOTAL = 12;
+
+// IMIX第i类帧的UDP载荷长度（生成的帧不含FCS）
+constexpr size_t imixPayload(size_t i) {
+    return IMIX_FRAMES[i] - datalink::ETHERNET_FCS_SIZE - sender::FRAME_HEADROOM;
+}
+
+network::IPv4Address addressAt(const AddressRange& range, uint32_t index) {
+    uint32_t value = common::loadBE32(range.start.data()) + index % range.count;
+    network::IPv4Address address;
+    common::storeBE32(address.data(), value);
+    return address;
+}
+
+uint16_t portAt(const PortRange& range, uint32_t index) {
+    return static_cast<uint16_t>(range.start + index % range.count);
+}
+
+uint64_t nowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+} // namespace
+
+Generator::Generator(const GeneratorConfig& config)
+    : config_(config), generated_(0), rng_(0), nextFlow_(0) {
+    if (config_.flows == 0 || config_.batchSize == 0) {
+        throw std::runtime_error("Generator needs at least one flow and a positive batch size");
+    }
+    if (config_.srcIP.count == 0 || config_.dstIP.count == 0 ||
+        config_.srcPort.count == 0 || config_.dstPort.count == 0) {
+        throw std::runtime_error("Generator address and port ranges must not be empty");
+    }
+    if (config_.flows > MAX_FLOWS) {
+        throw std::runtime_error("Generator flow count " + std::to_string(config_.flows) +
+                                 " exceeds the limit of " + std::to_string(MAX_FLOWS));
+    }
+    // 流模板超过地址/端口组合数时会重复已有的流（组合数只需算到超过MAX_FLOWS为止）
+    uint64_t combinations = 1;
+    for (uint32_t count : {config_.srcIP.count, config_.dstIP.count, config_.srcPort.count,
+                           config_.dstPort.count}) {
+        combinations = std::min<uint64_t>(combinations * count, MAX_FLOWS + 1ULL);
+    }
+    if (config_.flows > combinations) {
+        throw std::runtime_error("Generator flow count " + std::to_string(config_.flows) + " exceeds the " +
+                                 std::to_string(combinations) + " distinct address/port combinations");
+    }
+    if (config_.minPayload > config_.maxPayload || config_.maxPayload > MAX_PAYLOAD) {
+        throw std::runtime_error("Invalid generator payload size range");
+    }
+    
+    // 流模板i依次在源地址、目的地址、源端口、目的端口区间上取值（混合进制）
+    sender::Config base = sender::Sender::defaultConfig();
+    if (config_.sizeMode == SizeMode::Imix) {
+        // 生成器不分片，每类IMIX帧的IP数据报都必须不超过MTU
+        for (size_t i = 0; i < sizeof(IMIX_FRAMES) / sizeof(IMIX_FRAMES[0]); ++i) {
+            if (sender::FRAME_HEADROOM - datalink::ETHERNET_HEADER_SIZE + imixPayload(i) > base.mtu) {
+                throw std::runtime_error("IMIX frame of " + std::to_string(IMIX_FRAMES[i]) +
+                                         " bytes exceeds the MTU of " + std::to_string(base.mtu));
+            }
+        }
+    }
+    configs_.reserve(config_.flows);
+    templates_.reserve(config_.flows);
+    for (size_t i = 0; i < config_.flows; ++i) {
+        uint32_t index = static_cast<uint32_t>(i);
+        sender::Config flow = base;
+        flow.srcIP = addressAt(config_.srcIP, index);
+        index /= config_.srcIP.count;
+        flow.dstIP = addressAt(config_.dstIP, index);
+        index /= config_.dstIP.count;
+        flow.srcPort = portAt(config_.srcPort, index);
+        index /= config_.srcPort.count;
+        flow.dstPort = portAt(config_.dstPort, index);
+        configs_.push_back(flow);
+        templates_.emplace_back(flow);
+    }
+    
+    size_t maxPayload = config_.sizeMode == SizeMode::Imix ? imixPayload(2) : config_.maxPayload;
+    payload_.resize(maxPayload);
+    for (size_t i = 0; i < payload_.size(); ++i) {
+        payload_[i] = static_cast<uint8_t>('a' + i % 26);
+    }
+    reset();
+}
+
+void Generator::reset() {
+    generated_ = 0;
+    nextFlow_ = 0;
+    rng_ = config_.seed * 0x9E3779B97F4A7C15ULL + 1;
+}
+
+size_t Generator::nextPayloadSize() {
+    if (config_.sizeMode == SizeMode::Fixed) {
+        return config_.minPayload;
+    }
+    
+    // xorshift64
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 7;
+    rng_ ^= rng_ << 17;
+    if (config_.sizeMode == SizeMode::Uniform) {
+        return config_.minPayload + rng_ % (config_.maxPayload - config_.minPayload + 1);
+    }
+    uint32_t pick = static_cast<uint32_t>(rng_ % IMIX_TOTAL);
+    size_t i = 0;
+    while (pick >= IMIX_WEIGHTS[i]) {
+        pick -= IMIX_WEIGHTS[i];
+        ++i;
+    }
+    return imixPayload(i);
+}
+
+size_t Generator::nextBatch(common::FrameBatch& batch) {
+    batch.clear();
+    uint64_t remaining = config_.packets - generated_;
+    size_t count = static_cast<size_t>(std::min<uint64_t>(remaining, config_.batchSize));
+    for (size_t i = 0; i < count; ++i) {
+        common::ByteView payload(payload_.data(), nextPayloadSize());
+        const sender::HeaderTemplate& headers = templates_[nextFlow_];
+        headers.writeFrame(batch.appendFrame(headers.size() + payload.size()), payload);
+        if (++nextFlow_ == templates_.size()) {
+            nextFlow_ = 0;
+        }
+    }
+    generated_ += count;
+    return count;
+}
+
+GeneratorStats Generator::run(io::FrameWriter& out) {
+    GeneratorStats stats;
+    common::FrameBatch batch;
+    batch.reserve(config_.batchSize, config_.batchSize * (payload_.size() + sender::FRAME_HEADROOM));
+    
+    uint64_t start = nowNs();
+    while (nextBatch(batch) > 0) {
+        out.write(batch);
+        stats.packets += batch.count();
+        stats.bytes += batch.bytes();
+    }
+    out.flush();
+    stats.elapsedNs = nowNs() - start;
+    return stats;
+}
+
+void parseSizeSpec(const std::string& spec, GeneratorConfig& config) {
+    if (spec == "imix") {
+        config.sizeMode = SizeMode::Imix;
+        return;
+    }
+    size_t dash = spec.find('-');
+    try {
+        if (dash == std::string::npos) {
+            config.sizeMode = SizeMode::Fixed;
+            config.minPayload = config.maxPayload = std::stoul(spec);
+        } else {
+            config.sizeMode = SizeMode::Uniform;
+            config.minPayload = std::stoul(spec.substr(0, dash));
+            config.maxPayload = std::stoul(spec.substr(dash + 1));
+        }
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid payload size: " + spec);
+    }
+    if (config.minPayload > config.maxPayload || config.maxPayload > MAX_PAYLOAD) {
+        throw std::runtime_error("Invalid payload size: " + spec);
+    }
+}
+
+AddressRange parseAddressRange(const std::string& spec) {
+    AddressRange range;
+    size_t dash = spec.find('-');
+    range.start = network::IPv4Packet::parseIP(spec.substr(0, dash));
+    if (dash != std::string::npos) {
+        uint32_t first = common::loadBE32(range.start.data());
+        auto endAddress = network::IPv4Packet::parseIP(spec.substr(dash + 1));
+        uint32_t last = common::loadBE32(endAddress.data());
+        if (last < first) {
+            throw std::runtime_error("Invalid address range: " + spec);
+        }
+        // 地址个数用32位计数，整个IPv4地址空间（2^32个）无法表示
+        if (last - first == UINT32_MAX) {
+            throw std::runtime_error("Invalid address range: " + spec +
+                                     " (a range may cover at most 4294967295 addresses)");
+        }
+        range.count = last - first + 1;
+    }
+    return range;
+}
+
+PortRange parsePortRange(const std::string& spec) {
+    PortRange range;
+    size_t dash = spec.find('-');
+    unsigned long first;
+    unsigned long last;
+    try {
+        first = std::stoul(spec.substr(0, dash));
+        last = dash == std::string::npos ? first : std::stoul(spec.substr(dash + 1));
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid port range: " + spec);
+    }
+    if (first > 0xFFFF || last > 0xFFFF || last < first) {
+        throw std::runtime_error("Invalid port range: " + spec);
+    }
+    range.start = static_cast<uint16_t>(first);
+    range.count = static_cast<uint32_t>(last - first + 1);
+    return range;
+}
+
+} // namespace generator
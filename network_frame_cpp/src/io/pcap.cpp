@@ -0,0 +1,234 @@
+#include "io/pcap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace io {
+
+namespace {
+
+std::string errnoMessage(const std::string& what, const std::string& filename) {
+    return what + ": " + filename + " (" + std::strerror(errno) + ")";
+}
+
+void storeU32(uint8_t* p, uint32_t value) {
+    std::memcpy(p, &value, sizeof(value));
+}
+
+void storeU16(uint8_t* p, uint16_t value) {
+    std::memcpy(p, &value, sizeof(value));
+}
+
+uint32_t byteSwap32(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+} // namespace
+
+bool isPcapFile(const std::string& filename) {
+    const std::string ext = ".pcap";
+    return filename.size() >= ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+PcapWriter::PcapWriter(const std::string& filename, size_t bufferSize)
+    : fd_(-1), filename_(filename), buffer_(std::max(bufferSize, PCAP_GLOBAL_HEADER_SIZE)),
+      used_(0), frames_(0) {
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error(errnoMessage("Failed to open file for writing", filename));
+    }
+    
+    // 全局文件头（主机字节序，读取方根据魔数判断字节序）
+    uint8_t* p = buffer_.data();
+    storeU32(p, PCAP_MAGIC_NANO);
+    storeU16(p + 4, 2);   // 主版本号
+    storeU16(p + 6, 4);   // 次版本号
+    storeU32(p + 8, 0);   // 时区
+    storeU32(p + 12, 0);  // 时间戳精度
+    storeU32(p + 16, PCAP_SNAPLEN);
+    storeU32(p + 20, PCAP_LINKTYPE_ETHERNET);
+    used_ = PCAP_GLOBAL_HEADER_SIZE;
+}
+
+PcapWriter::~PcapWriter() {
+    try {
+        close();
+    } catch (...) {
+        // 析构函数中不抛出异常
+    }
+}
+
+void PcapWriter::write(common::ByteView frame) {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    write(frame, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+}
+
+void PcapWriter::write(common::ByteView frame, uint64_t timestampNs) {
+    if (fd_ < 0) {
+        throw std::runtime_error("pcap writer is closed: " + filename_);
+    }
+    
+    uint32_t capturedLen = static_cast<uint32_t>(std::min<size_t>(frame.size(), PCAP_SNAPLEN));
+    size_t recordSize = PCAP_RECORD_HEADER_SIZE + capturedLen;
+    if (used_ + recordSize > buffer_.size()) {
+        flush();
+    }
+    
+    // 超过缓冲区容量的大记录直接写出
+    if (recordSize > buffer_.size()) {
+        uint8_t header[PCAP_RECORD_HEADER_SIZE];
+        storeU32(header, static_cast<uint32_t>(timestampNs / 1000000000ULL));
+        storeU32(header + 4, static_cast<uint32_t>(timestampNs % 1000000000ULL));
+        storeU32(header + 8, capturedLen);
+        storeU32(header + 12, static_cast<uint32_t>(frame.size()));
+        writeAll(header, sizeof(header));
+        writeAll(frame.data(), capturedLen);
+        ++frames_;
+        return;
+    }
+    
+    uint8_t* p = buffer_.data() + used_;
+    storeU32(p, static_cast<uint32_t>(timestampNs / 1000000000ULL));
+    storeU32(p + 4, static_cast<uint32_t>(timestampNs % 1000000000ULL));
+    storeU32(p + 8, capturedLen);
+    storeU32(p + 12, static_cast<uint32_t>(frame.size()));
+    std::memcpy(p + PCAP_RECORD_HEADER_SIZE, frame.data(), capturedLen);
+    used_ += recordSize;
+    ++frames_;
+}
+
+void PcapWriter::write(const common::FrameBatch& batch) {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    uint64_t timestampNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    for (size_t i = 0; i < batch.count(); ++i) {
+        write(batch.frame(i), timestampNs);
+    }
+}
+
+void PcapWriter::flush() {
+    if (used_ > 0) {
+        writeAll(buffer_.data(), used_);
+        used_ = 0;
+    }
+}
+
+void PcapWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void PcapWriter::writeAll(const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd_, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(errnoMessage("Failed to write file", filename_));
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+}
+
+PcapReader::PcapReader(const std::string& filename)
+    : map_(nullptr), size_(0), offset_(PCAP_GLOBAL_HEADER_SIZE),
+      swapped_(false), nanosecond_(false), linkType_(0) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to open file for reading", filename));
+    }
+    
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error(errnoMessage("Failed to stat file", filename));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ < PCAP_GLOBAL_HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("File too short for pcap header: " + filename);
+    }
+    
+    void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error(errnoMessage("Failed to map file", filename));
+    }
+    map_ = static_cast<const uint8_t*>(map);
+    ::madvise(map, size_, MADV_SEQUENTIAL);
+    
+    uint32_t magic;
+    std::memcpy(&magic, map_, sizeof(magic));
+    if (magic == PCAP_MAGIC_MICRO || magic == PCAP_MAGIC_NANO) {
+        swapped_ = false;
+    } else if (byteSwap32(magic) == PCAP_MAGIC_MICRO || byteSwap32(magic) == PCAP_MAGIC_NANO) {
+        swapped_ = true;
+        magic = byteSwap32(magic);
+    } else {
+        ::munmap(map, size_);
+        throw std::runtime_error("Invalid pcap magic number: " + filename);
+    }
+    nanosecond_ = (magic == PCAP_MAGIC_NANO);
+    linkType_ = readU32(20);
+}
+
+PcapReader::~PcapReader() {
+    if (map_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(map_), size_);
+    }
+}
+
+bool PcapReader::next(PcapRecord& record) {
+    if (offset_ >= size_) {
+        return false;
+    }
+    if (size_ - offset_ < PCAP_RECORD_HEADER_SIZE) {
+        throw std::runtime_error("Truncated pcap record header");
+    }
+    
+    uint32_t seconds = readU32(offset_);
+    uint32_t fraction = readU32(offset_ + 4);
+    uint32_t capturedLen = readU32(offset_ + 8);
+    uint32_t originalLen = readU32(offset_ + 12);
+    size_t dataOffset = offset_ + PCAP_RECORD_HEADER_SIZE;
+    if (size_ - dataOffset < capturedLen) {
+        throw std::runtime_error("Truncated pcap record data");
+    }
+    
+    record.timestampNs = static_cast<uint64_t>(seconds) * 1000000000ULL +
+                         (nanosecond_ ? fraction : static_cast<uint64_t>(fraction) * 1000ULL);
+    record.originalLength = originalLen;
+    record.data = common::ByteView(map_ + dataOffset, capturedLen);
+    offset_ = dataOffset + capturedLen;
+    return true;
+}
+
+bool PcapReader::next(common::ByteView& frame) {
+    PcapRecord record;
+    if (!next(record)) {
+        return false;
+    }
+    frame = record.data;
+    return true;
+}
+
+uint32_t PcapReader::readU32(size_t offset) const {
+    uint32_t value;
+    std::memcpy(&value, map_ + offset, sizeof(value));
+    return swapped_ ? byteSwap32(value) : value;
+}
+
+} // namespace io
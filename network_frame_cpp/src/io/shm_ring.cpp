@@ -0,0 +1,324 @@
+#include "io/shm_ring.h"
+#include "common/spsc_ring.h"
+#include "common/cpu_relax.h"
+#include <atomic>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+namespace io {
+
+namespace {
+
+const std::string SHM_PREFIX = "shm://";
+constexpr uint32_t SHM_MAGIC = 0x4E465352;   // "NFSR"
+constexpr uint32_t SHM_VERSION = 1;
+constexpr size_t SHM_HEADER_AREA = 4096;
+constexpr uint32_t SPIN_MIN = 64;
+constexpr uint32_t SPIN_MAX = 65536;
+constexpr long FUTEX_TIMEOUT_NS = 100 * 1000 * 1000;
+
+// 跨进程futex（不能使用FUTEX_PRIVATE_FLAG）
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    timespec timeout{0, FUTEX_TIMEOUT_NS};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+// 对端在休眠时递增序号并唤醒
+// 调用前已发布索引，seq_cst栅栏与对端“置等待标志后重新检查索引”配对，避免丢失唤醒
+void wakeIfWaiting(std::atomic<uint32_t>& waiting, std::atomic<uint32_t>& seq) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+        seq.fetch_add(1, std::memory_order_release);
+        futexWake(&seq);
+    }
+}
+
+std::string errnoMessage(const std::string& what, const std::string& name) {
+    return what + ": " + name + " (" + std::strerror(errno) + ")";
+}
+
+size_t roundUpPow2(size_t value) {
+    size_t size = 2;
+    while (size < value) {
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace
+
+// 映射起始处的共享控制区，生产者与消费者的字段各占独立缓存行
+struct ShmRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t slots;
+    uint64_t slotSize;
+
+    alignas(common::CACHE_LINE_SIZE) std::atomic<uint64_t> tail;  // 生产者写入位置
+    std::atomic<uint32_t> dataSeq;                                 // 消费者休眠的futex字
+    std::atomic<uint32_t> closed;
+
+    alignas(common::CACHE_LINE_SIZE) std::atomic<uint64_t> head;  // 消费者读取位置
+    std::atomic<uint32_t> spaceSeq;                                // 生产者休眠的futex字
+
+    alignas(common::CACHE_LINE_SIZE) std::atomic<uint32_t> consumerWaiting;
+    std::atomic<uint32_t> producerWaiting;
+};
+
+static_assert(sizeof(ShmRingHeader) <= SHM_HEADER_AREA, "ring header must fit its area");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+bool isShmAddress(const std::string& name) {
+    return name.compare(0, SHM_PREFIX.size(), SHM_PREFIX) == 0;
+}
+
+ShmRingConfig parseShmAddress(const std::string& name, const ShmRingConfig& base) {
+    if (!isShmAddress(name) || name.size() == SHM_PREFIX.size()) {
+        throw std::runtime_error("Invalid shared memory address: " + name);
+    }
+    ShmRingConfig config = base;
+    std::string object = name.substr(SHM_PREFIX.size());
+    if (object.find('/') != std::string::npos) {
+        throw std::runtime_error("Invalid shared memory address: " + name);
+    }
+    config.name = "/" + object;
+    return config;
+}
+
+ShmRing::ShmRing(const ShmRingConfig& config, bool create)
+    : ring_(nullptr), slotData_(nullptr), mapSize_(0), mask_(0), name_(config.name),
+      owner_(create), spinLimit_(1024) {
+    int fd;
+    if (create) {
+        size_t slots = roundUpPow2(config.slots);
+        size_t slotSize = (config.slotSize + common::CACHE_LINE_SIZE - 1) & ~(common::CACHE_LINE_SIZE - 1);
+        if (slotSize <= SHM_SLOT_HEADER_SIZE) {
+            throw std::runtime_error("Shared memory slot size too small");
+        }
+        mapSize_ = SHM_HEADER_AREA + slots * slotSize;
+        
+        fd = shm_open(name_.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            throw std::runtime_error(errnoMessage("Failed to create shared memory", name_));
+        }
+        // 先截断为0，残留的旧环内容全部清零
+        if (ftruncate(fd, 0) < 0 || ftruncate(fd, static_cast<off_t>(mapSize_)) < 0) {
+            std::string message = errnoMessage("Failed to size shared memory", name_);
+            ::close(fd);
+            shm_unlink(name_.c_str());
+            throw std::runtime_error(message);
+        }
+    } else {
+        fd = shm_open(name_.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::runtime_error(errnoMessage("Failed to open shared memory (is the receiver running?)", name_));
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < SHM_HEADER_AREA) {
+            ::close(fd);
+            throw std::runtime_error("Shared memory ring not initialized: " + name_);
+        }
+        mapSize_ = static_cast<size_t>(st.st_size);
+    }
+    
+    void* map = mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        if (create) {
+            shm_unlink(name_.c_str());
+        }
+        throw std::runtime_error(errnoMessage("Failed to map shared memory", name_));
+    }
+    slotData_ = static_cast<uint8_t*>(map) + SHM_HEADER_AREA;
+    
+    if (create) {
+        ring_ = new (map) ShmRingHeader();
+        ring_->version = SHM_VERSION;
+        ring_->slots = roundUpPow2(config.slots);
+        ring_->slotSize = (mapSize_ - SHM_HEADER_AREA) / ring_->slots;
+        // magic最后写入，生产者看到magic即可使用其余字段
+        std::atomic_thread_fence(std::memory_order_release);
+        ring_->magic = SHM_MAGIC;
+    } else {
+        ring_ = static_cast<ShmRingHeader*>(map);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ring_->magic != SHM_MAGIC || ring_->version != SHM_VERSION ||
+            ring_->slots == 0 || SHM_HEADER_AREA + ring_->slots * ring_->slotSize != mapSize_) {
+            munmap(map, mapSize_);
+            throw std::runtime_error("Invalid shared memory ring: " + name_);
+        }
+    }
+    mask_ = ring_->slots - 1;
+}
+
+ShmRing::~ShmRing() {
+    munmap(ring_, mapSize_);
+    if (owner_) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+size_t ShmRing::slots() const {
+    return ring_->slots;
+}
+
+size_t ShmRing::slotSize() const {
+    return ring_->slotSize;
+}
+
+void ShmRing::spinSucceeded() {
+    if (spinLimit_ < SPIN_MAX) {
+        spinLimit_ <<= 1;
+    }
+}
+
+void ShmRing::spinFailed() {
+    if (spinLimit_ > SPIN_MIN) {
+        spinLimit_ >>= 1;
+    }
+}
+
+ShmRingWriter::ShmRingWriter(const ShmRingConfig& config)
+    : ShmRing(config, false), tail_(0), cachedHead_(0), frames_(0), sleeps_(0), closed_(false) {
+    tail_ = ring_->tail.load(std::memory_order_relaxed);
+    cachedHead_ = ring_->head.load(std::memory_order_acquire);
+}
+
+ShmRingWriter::~ShmRingWriter() {
+    close();
+}
+
+uint8_t* ShmRingWriter::reserve(size_t size) {
+    if (size > maxFrameSize()) {
+        throw std::runtime_error("Frame too large for shared memory slot: " + std::to_string(size));
+    }
+    if (tail_ - cachedHead_ <= mask_) {
+        return slot(tail_) + SHM_SLOT_HEADER_SIZE;
+    }
+    
+    // 环已满：先自旋，再在spaceSeq上休眠直到消费者释放槽位
+    uint32_t spins = 0;
+    for (;;) {
+        cachedHead_ = ring_->head.load(std::memory_order_acquire);
+        if (tail_ - cachedHead_ <= mask_) {
+            if (spins > 0) {
+                spinSucceeded();
+            }
+            return slot(tail_) + SHM_SLOT_HEADER_SIZE;
+        }
+        if (++spins < spinLimit_) {
+            common::cpuRelax();
+            continue;
+        }
+        
+        uint32_t seq = ring_->spaceSeq.load(std::memory_order_acquire);
+        ring_->producerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cachedHead_ = ring_->head.load(std::memory_order_acquire);
+        if (tail_ - cachedHead_ > mask_) {
+            futexWait(&ring_->spaceSeq, seq);
+            ++sleeps_;
+        }
+        ring_->producerWaiting.store(0, std::memory_order_relaxed);
+        spinFailed();
+        spins = 0;
+    }
+}
+
+void ShmRingWriter::commit(size_t size) {
+    uint32_t length = static_cast<uint32_t>(size);
+    std::memcpy(slot(tail_), &length, sizeof(length));
+    ring_->tail.store(++tail_, std::memory_order_release);
+    ++frames_;
+    wakeIfWaiting(ring_->consumerWaiting, ring_->dataSeq);
+}
+
+void ShmRingWriter::write(common::ByteView frame) {
+    std::memcpy(reserve(frame.size()), frame.data(), frame.size());
+    commit(frame.size());
+}
+
+void ShmRingWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    ring_->closed.store(1, std::memory_order_release);
+    ring_->dataSeq.fetch_add(1, std::memory_order_release);
+    futexWake(&ring_->dataSeq);
+}
+
+ShmRingReader::ShmRingReader(const ShmRingConfig& config)
+    : ShmRing(config, true), head_(0), cachedTail_(0), holding_(false), frames_(0), sleeps_(0) {}
+
+ShmRingReader::~ShmRingReader() = default;
+
+bool ShmRingReader::next(common::ByteView& frame) {
+    // 释放上一次返回的槽位
+    if (holding_) {
+        ring_->head.store(++head_, std::memory_order_release);
+        holding_ = false;
+        wakeIfWaiting(ring_->producerWaiting, ring_->spaceSeq);
+    }
+    
+    uint32_t spins = 0;
+    while (head_ == cachedTail_) {
+        cachedTail_ = ring_->tail.load(std::memory_order_acquire);
+        if (head_ != cachedTail_) {
+            if (spins > 0) {
+                spinSucceeded();
+            }
+            break;
+        }
+        if (ring_->closed.load(std::memory_order_acquire)) {
+            // 关闭前提交的帧仍需读完
+            cachedTail_ = ring_->tail.load(std::memory_order_acquire);
+            if (head_ == cachedTail_) {
+                return false;
+            }
+            break;
+        }
+        if (++spins < spinLimit_) {
+            common::cpuRelax();
+            continue;
+        }
+        
+        uint32_t seq = ring_->dataSeq.load(std::memory_order_acquire);
+        ring_->consumerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring_->tail.load(std::memory_order_acquire) == head_ &&
+            !ring_->closed.load(std::memory_order_acquire)) {
+            futexWait(&ring_->dataSeq, seq);
+            ++sleeps_;
+        }
+        ring_->consumerWaiting.store(0, std::memory_order_relaxed);
+        spinFailed();
+        spins = 0;
+    }
+    
+    const uint8_t* current = slot(head_);
+    holding_ = true;
+    ++frames_;
+    uint32_t length;
+    std::memcpy(&length, current, sizeof(length));
+    if (length > maxFrameSize()) {
+        throw std::runtime_error("Corrupt shared memory slot length: " + std::to_string(length));
+    }
+    frame = common::ByteView(current + SHM_SLOT_HEADER_SIZE, length);
+    return true;
+}
+
+} // namespace io
@@ -0,0 +1,264 @@
+#include "io/socket.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace io {
+
+namespace {
+
+const std::string SOCKET_PREFIX = "udp://";
+
+std::string errnoMessage(const std::string& what) {
+    return what + " (" + std::strerror(errno) + ")";
+}
+
+sockaddr_in makeAddress(const SocketConfig& config) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &address.sin_addr) != 1) {
+        throw std::runtime_error("Invalid socket address: " + config.host);
+    }
+    return address;
+}
+
+int openSocket() {
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to create socket"));
+    }
+    return fd;
+}
+
+// 批内每个mmsghdr对应一个iovec
+void linkMessages(std::vector<mmsghdr>& messages, std::vector<iovec>& iov, sockaddr_in* address) {
+    for (size_t i = 0; i < messages.size(); ++i) {
+        std::memset(&messages[i], 0, sizeof(messages[i]));
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        if (address) {
+            messages[i].msg_hdr.msg_name = address;
+            messages[i].msg_hdr.msg_namelen = sizeof(*address);
+        }
+    }
+}
+
+} // namespace
+
+bool isSocketAddress(const std::string& name) {
+    return name.compare(0, SOCKET_PREFIX.size(), SOCKET_PREFIX) == 0;
+}
+
+SocketConfig parseSocketAddress(const std::string& name, const SocketConfig& base) {
+    if (!isSocketAddress(name)) {
+        throw std::runtime_error("Invalid socket address: " + name);
+    }
+    SocketConfig config = base;
+    std::string rest = name.substr(SOCKET_PREFIX.size());
+    size_t colon = rest.rfind(':');
+    std::string host = colon == std::string::npos ? rest : rest.substr(0, colon);
+    if (!host.empty()) {
+        config.host = host;
+    }
+    if (colon != std::string::npos) {
+        unsigned long port = std::stoul(rest.substr(colon + 1));
+        if (port == 0 || port > 0xFFFF) {
+            throw std::runtime_error("Invalid socket port: " + name);
+        }
+        config.port = static_cast<uint16_t>(port);
+    }
+    return config;
+}
+
+SocketWriter::SocketWriter(const SocketConfig& config)
+    : fd_(-1), config_(config), address_(makeAddress(config)), frames_(0), syscalls_(0) {
+    if (config_.batchSize == 0) {
+        config_.batchSize = 1;
+    }
+    fd_ = openSocket();
+    int size = SOCKET_BUFFER_SIZE;
+    setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    
+    // 使用sendto语义而不connect，接收端未启动时不会收到ECONNREFUSED
+    iov_.resize(config_.batchSize);
+    messages_.resize(config_.batchSize);
+    linkMessages(messages_, iov_, &address_);
+    staged_.reserve(config_.batchSize, config_.batchSize * 2048);
+}
+
+SocketWriter::~SocketWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    ::close(fd_);
+}
+
+void SocketWriter::write(common::ByteView frame) {
+    if (frame.size() > SOCKET_MAX_FRAME_SIZE) {
+        throw std::runtime_error("Frame too large for socket transport: " + std::to_string(frame.size()));
+    }
+    std::memcpy(staged_.appendFrame(frame.size()), frame.data(), frame.size());
+    if (staged_.count() == config_.batchSize) {
+        flush();
+    }
+}
+
+void SocketWriter::write(const common::FrameBatch& batch) {
+    flush();
+    sendBatch(batch);
+}
+
+void SocketWriter::flush() {
+    if (staged_.empty()) {
+        return;
+    }
+    sendBatch(staged_);
+    staged_.clear();
+}
+
+void SocketWriter::sendBatch(const common::FrameBatch& batch) {
+    size_t i = 0;
+    while (i < batch.count()) {
+        size_t count = std::min(config_.batchSize, batch.count() - i);
+        for (size_t j = 0; j < count; ++j) {
+            common::ByteView frame = batch.frame(i + j);
+            if (frame.size() > SOCKET_MAX_FRAME_SIZE) {
+                throw std::runtime_error("Frame too large for socket transport: " +
+                                         std::to_string(frame.size()));
+            }
+            iov_[j].iov_base = const_cast<uint8_t*>(frame.data());
+            iov_[j].iov_len = frame.size();
+        }
+        send(count);
+        i += count;
+    }
+}
+
+void SocketWriter::send(size_t count) {
+    size_t sent = 0;
+    while (sent < count) {
+        int n = sendmmsg(fd_, messages_.data() + sent, static_cast<unsigned int>(count - sent), 0);
+        ++syscalls_;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // 发送队列暂满，让出CPU后重试
+            if (errno == ENOBUFS || errno == EAGAIN) {
+                sched_yield();
+                continue;
+            }
+            throw std::runtime_error(errnoMessage("sendmmsg failed"));
+        }
+        sent += static_cast<size_t>(n);
+    }
+    frames_ += count;
+}
+
+SocketReader::SocketReader(const SocketConfig& config)
+    : fd_(-1), config_(config), count_(0), index_(0), frames_(0), truncated_(0), syscalls_(0) {
+    if (config_.batchSize == 0) {
+        config_.batchSize = 1;
+    }
+    sockaddr_in address = makeAddress(config_);
+    fd_ = openSocket();
+    
+    int on = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    int size = SOCKET_BUFFER_SIZE;
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::string message = errnoMessage("Failed to bind " + config_.host + ":" +
+                                           std::to_string(config_.port));
+        ::close(fd_);
+        throw std::runtime_error(message);
+    }
+    
+    if (config_.busyPoll) {
+#ifdef SO_BUSY_POLL
+        // 内核忙轮询需要权限，失败时仅保留用户态轮询
+        int busyPollUs = 50;
+        setsockopt(fd_, SOL_SOCKET, SO_BUSY_POLL, &busyPollUs, sizeof(busyPollUs));
+#endif
+    } else {
+        // 阻塞接收的超时即空闲超时
+        timeval timeout;
+        timeout.tv_sec = config_.idleTimeoutMs / 1000;
+        timeout.tv_usec = (config_.idleTimeoutMs % 1000) * 1000;
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    
+    buffer_.resize(config_.batchSize * SOCKET_MAX_FRAME_SIZE);
+    iov_.resize(config_.batchSize);
+    messages_.resize(config_.batchSize);
+    for (size_t i = 0; i < iov_.size(); ++i) {
+        iov_[i].iov_base = buffer_.data() + i * SOCKET_MAX_FRAME_SIZE;
+        iov_[i].iov_len = SOCKET_MAX_FRAME_SIZE;
+    }
+    linkMessages(messages_, iov_, nullptr);
+}
+
+SocketReader::~SocketReader() {
+    ::close(fd_);
+}
+
+bool SocketReader::next(common::ByteView& frame) {
+    while (index_ == count_) {
+        if (!receive()) {
+            return false;
+        }
+    }
+    
+    const mmsghdr& message = messages_[index_++];
+    if (message.msg_hdr.msg_flags & MSG_TRUNC) {
+        ++truncated_;
+    }
+    frame = common::ByteView(static_cast<const uint8_t*>(message.msg_hdr.msg_iov->iov_base),
+                             message.msg_len);
+    ++frames_;
+    return true;
+}
+
+bool SocketReader::receive() {
+    using Clock = std::chrono::steady_clock;
+    auto idleSince = Clock::now();
+    int flags = config_.busyPoll ? MSG_DONTWAIT : MSG_WAITFORONE;
+    
+    for (;;) {
+        int n = recvmmsg(fd_, messages_.data(), static_cast<unsigned int>(messages_.size()), flags, nullptr);
+        ++syscalls_;
+        if (n > 0) {
+            count_ = static_cast<size_t>(n);
+            index_ = 0;
+            return true;
+        }
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            throw std::runtime_error(errnoMessage("recvmmsg failed"));
+        }
+        
+        // 首帧到达前一直等待
+        if (frames_ == 0) {
+            continue;
+        }
+        if (!config_.busyPoll) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - idleSince);
+        if (idle.count() >= config_.idleTimeoutMs) {
+            return false;
+        }
+    }
+}
+
+} // namespace io
@@ -1,49 +1,760 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <algorithm>
 #include "application/application.h"
+#include "io/pcap.h"
+#include "io/socket.h"
+#include "io/shm_ring.h"
 #include "sender/sender.h"
 #include "receiver/receiver.h"
+#include "receiver/pipeline.h"
+#include "flow/flow_table.h"
+#include "filter/filter.h"
+#include "generator/generator.h"
+#include "sender/pacer.h"
+#include "common/tsc_clock.h"
+#include "trace/trace.h"
 
 const std::string DEFAULT_FILENAME = "packet.bin";
 const std::string DEFAULT_MESSAGE = "Hello Teacher";
 
+// 跟踪模式：off / summary / detail / binary:<文件名>，为空时使用各命令的默认值
+std::string g_traceMode;
+std::ofstream g_traceFile;
+
+// 以IPv6封装（--ipv6）
+bool g_ipv6 = false;
+
+// 以TCP分段卸载（--tcp）或UDP分段卸载（--gso）发送
+bool g_tcp = false;
+bool g_gso = false;
+
+// 接收端选项（--no-verify关闭校验和验证）
+receiver::Options g_receiverOptions;
+
+// 多核接收（--workers=N、--pin）
+size_t g_workers = 1;
+bool g_pinCores = false;
+
+// 回环套接字传输（--batch=N、--busy-poll）
+io::SocketConfig g_socketConfig;
+
+// 生成器选项（--count、--flow-count、--src-ip等），在gen命令中解析
+std::vector<std::string> g_generatorArgs;
+// 限速发送的总速率与突发大小，在pace命令中使用
+std::string g_rate = "10kpps";
+size_t g_burst = 1;
+
+// 包过滤表达式（--filter=<表达式>）
+std::string g_filterExpression;
+
+// 流统计导出文件（--flows=<文件>）
+std::string g_flowFile;
+
+// 流统计：按五元组累计报文，定期导出空闲流，结束时导出剩余的流
+struct FlowRecorder {
+    static constexpr uint64_t EXPIRE_INTERVAL = 65536;
+
+    std::ofstream file;
+    std::unique_ptr<flow::FlowExporter> exporter;
+    flow::FlowTable table;
+    uint64_t sinceExpire = 0;
+
+    void record(const receiver::PacketView& packet) {
+        uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        // 流记录格式只容纳IPv4地址，IPv6报文不计入
+        if (packet.isIPv6()) {
+            return;
+        }
+        table.update(flow::FlowKey::fromView(packet.ipv4, packet.udp), packet.ipv4.totalLength(), now);
+        if (++sinceExpire == EXPIRE_INTERVAL) {
+            table.expire(now, exporter.get());
+            sinceExpire = 0;
+        }
+    }
+
+    void finish() {
+        uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        size_t active = table.flush(now, exporter.get());
+        exporter->flush();
+        std::cout << "Flows: " << table.stats().created << " (" << active << " active at end, "
+                  << table.stats().dropped << " packets over capacity), exported to "
+                  << g_flowFile << std::endl;
+    }
+};
+
+std::unique_ptr<FlowRecorder> openFlowRecorder() {
+    if (g_flowFile.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<FlowRecorder> recorder(new FlowRecorder());
+    recorder->file.open(g_flowFile, std::ios::binary);
+    if (!recorder->file) {
+        throw std::runtime_error("Failed to open flow export file: " + g_flowFile);
+    }
+    recorder->exporter.reset(new flow::FlowExporter(recorder->file));
+    return recorder;
+}
+
+// 发送端配置：默认配置，--ipv6时改用IPv6地址封装
+sender::Config senderConfig() {
+    auto config = sender::Sender::defaultConfig();
+    config.ipv6 = g_ipv6;
+    return config;
+}
+
+// 按跟踪模式为Sender/Receiver配置输出
+void configureTracer(trace::Tracer& tracer, trace::Level defaultLevel) {
+    const std::string binaryPrefix = "binary:";
+    if (g_traceMode.compare(0, binaryPrefix.size(), binaryPrefix) == 0) {
+        if (!g_traceFile.is_open()) {
+            std::string filename = g_traceMode.substr(binaryPrefix.size());
+            g_traceFile.open(filename, std::ios::binary);
+            if (!g_traceFile) {
+                throw std::runtime_error("Failed to open trace file: " + filename);
+            }
+        }
+        tracer.attach(std::make_shared<trace::BinarySink>(g_traceFile), trace::Level::Summary);
+        return;
+    }
+    
+    trace::Level level = g_traceMode.empty() ? defaultLevel : trace::parseLevel(g_traceMode);
+    tracer.attach(std::make_shared<trace::TextSink>(std::cout), level);
+}
+
 void printUsage() {
     std::cout << "Network Protocol Simulation Program (C++)" << std::endl;
     std::cout << "==========================================" << std::endl;
     std::cout << "Usage:" << std::endl;
-    std::cout << "  ./network_frame send    - Encapsulate data and save to packet.bin" << std::endl;
-    std::cout << "  ./network_frame receive - Read packet.bin and decapsulate" << std::endl;
+    std::cout << "  ./network_frame send [message] [file] [count]" << std::endl;
+    std::cout << "                          - Encapsulate data and save to file (default packet.bin)" << std::endl;
+    std::cout << "                            a .pcap file may hold count copies of the frame" << std::endl;
+    std::cout << "                            messages over the MTU are sent as IPv4 fragments (.pcap output)" << std::endl;
+    std::cout << "                            udp://host:port sends count frames over a loopback socket" << std::endl;
+    std::cout << "                            shm://name writes count frames into a shared memory ring" << std::endl;
+    std::cout << "  ./network_frame receive [file]" << std::endl;
+    std::cout << "                          - Read file and decapsulate (.pcap: every frame)" << std::endl;
+    std::cout << "                            udp://host:port receives frames until the sender goes idle" << std::endl;
+    std::cout << "                            shm://name creates the ring and reads until the sender closes it" << std::endl;
+    std::cout << "  ./network_frame gen [output]" << std::endl;
+    std::cout << "                          - Generate synthetic traffic into a .pcap file, udp://, shm://" << std::endl;
+    std::cout << "                            or the in-memory receive pipeline (default: pipeline)" << std::endl;
+    std::cout << "  ./network_frame pace [output]" << std::endl;
+    std::cout << "                          - Send generator flows at --rate into a .pcap file, udp://, shm://" << std::endl;
+    std::cout << "                            or null (discard, default) and report rate and jitter" << std::endl;
+    std::cout << "  ./network_frame filter <in.pcap> <out.pcap>" << std::endl;
+    std::cout << "                          - Copy the frames matching --filter to a new capture" << std::endl;
     std::cout << "  ./network_frame demo    - Full demo (encapsulate + decapsulate)" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --trace=off|summary|detail|binary:<file>" << std::endl;
+    std::cout << "                          - Packet trace output (default: detail, off for .pcap input)" << std::endl;
+    std::cout << "  --no-verify             - Skip checksum verification (trusted links)" << std::endl;
+    std::cout << "  --ipv6                  - Encapsulate over IPv6 (fd00::100 -> fd00::1)" << std::endl;
+    std::cout << "  --tcp                   - Send count copies of the message as one TCP bulk transfer" << std::endl;
+    std::cout << "                            cut into MSS-sized segments (.pcap output)" << std::endl;
+    std::cout << "  --gso                   - Send count copies of the message as one bulk payload" << std::endl;
+    std::cout << "                            split into MTU-sized UDP datagrams (.pcap output)" << std::endl;
+    std::cout << "  --workers=N             - Decapsulate .pcap input on N worker threads" << std::endl;
+    std::cout << "  --pin                   - Pin worker threads to CPU cores" << std::endl;
+    std::cout << "  --batch=N               - Frames per sendmmsg/recvmmsg call (default 32)" << std::endl;
+    std::cout << "  --busy-poll             - Poll the socket instead of blocking" << std::endl;
+    std::cout << "  --filter=<expression>   - Drop frames not matching e.g. 'udp and dst port 80'" << std::endl;
+    std::cout << "  --flows=<file>          - Track IPv4 5-tuple flows and export them in binary batches" << std::endl;
+    std::cout << "Generator options:" << std::endl;
+    std::cout << "  --count=N               - Packets to generate (default 1000000)" << std::endl;
+    std::cout << "  --flow-count=N          - Flow templates, one Sender each (default 1, at most the address/port combinations)" << std::endl;
+    std::cout << "  --src-ip=A[-B] --dst-ip=A[-B] --src-port=N[-M] --dst-port=N[-M]" << std::endl;
+    std::cout << "                          - Address and port ranges combined into flow templates" << std::endl;
+    std::cout << "  --size=N|N-M|imix       - Payload size: fixed, uniform or IMIX (default 18)" << std::endl;
+    std::cout << "  --rate=N[pps|kpps|mpps|bps|kbps|mbps|gbps]" << std::endl;
+    std::cout << "                          - Total pace rate, split evenly across flows (default 10kpps)" << std::endl;
+    std::cout << "  --burst=N               - Frames a flow may send back to back (default 1)" << std::endl;
 }
 
-void runSender(const std::string& message) {
+void runSender(const std::string& message, const std::string& filename, uint64_t count) {
     std::cout << "========================================" << std::endl;
     std::cout << "       Encapsulation Module (Sender)" << std::endl;
     std::cout << "========================================" << std::endl << std::endl;
     
     application::Data appData(message);
     
-    auto config = sender::Sender::defaultConfig();
+    auto config = senderConfig();
     sender::Sender s(config);
+    configureTracer(s.tracer(), trace::Level::Detail);
     
-    s.encapsulateAndSave(appData, DEFAULT_FILENAME);
+    // 超过MTU的数据报按MTU切分为IPv4分片，一个数据报对应多帧，只能写入pcap文件
+    if (s.headerSize() - datalink::ETHERNET_HEADER_SIZE + appData.size() > config.mtu) {
+        if (!io::isPcapFile(filename)) {
+            throw std::runtime_error("Payload exceeds the MTU; fragmented output requires a .pcap file");
+        }
+        
+        io::PcapWriter writer(filename);
+        size_t fragments = 0;
+        for (uint64_t i = 0; i < std::max<uint64_t>(count, 1); ++i) {
+            // 每个数据报的分片各自使用新的IP标识
+            auto batch = s.encapsulateFragments(appData);
+            fragments = batch.count();
+            writer.write(batch);
+        }
+        writer.close();
+        
+        std::cout << "Network Layer (IPv4):" << std::endl;
+        std::cout << "  MTU: " << config.mtu << " bytes" << std::endl;
+        std::cout << "  Fragments per datagram: " << fragments << std::endl;
+        std::cout << "\nPhysical Layer:" << std::endl;
+        std::cout << "  Saved to file: " << filename << std::endl;
+        std::cout << "  Frames written: " << writer.framesWritten() << std::endl;
+    } else if (count <= 1) {
+        s.encapsulateAndSave(appData, filename);
+    } else {
+        if (!io::isPcapFile(filename)) {
+            throw std::runtime_error("Writing multiple frames requires a .pcap file");
+        }
+        
+        auto frame = s.encapsulate(appData);
+        io::PcapWriter writer(filename);
+        for (uint64_t i = 0; i < count; ++i) {
+            writer.write(frame);
+        }
+        writer.close();
+        
+        std::cout << "\nPhysical Layer:" << std::endl;
+        std::cout << "  Saved to file: " << filename << std::endl;
+        std::cout << "  Frames written: " << writer.framesWritten() << std::endl;
+    }
+    
+    std::cout << std::endl << "Encapsulation complete!" << std::endl;
+}
+
+void runSegmentSender(const std::string& message, const std::string& filename, uint64_t count) {
+    std::cout << "========================================" << std::endl;
+    std::cout << (g_tcp ? "    Encapsulation Module (TCP Sender)" : "    Encapsulation Module (GSO Sender)")
+              << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    if (!io::isPcapFile(filename)) {
+        throw std::runtime_error("Segmentation output requires a .pcap file");
+    }
+    
+    std::string bulk;
+    bulk.reserve(message.size() * count);
+    for (uint64_t i = 0; i < count; ++i) {
+        bulk += message;
+    }
+    application::Data appData(bulk);
+    
+    sender::Sender s(senderConfig());
+    auto batch = g_tcp ? s.encapsulateSegments(appData, 1, 1) : s.encapsulateDatagrams(appData);
+    
+    io::PcapWriter writer(filename);
+    writer.write(batch);
+    writer.close();
+    
+    std::cout << (g_tcp ? "Transport Layer (TCP):" : "Transport Layer (UDP):") << std::endl;
+    std::cout << "  Bulk data: " << appData.size() << " bytes" << std::endl;
+    std::cout << "  Segment size: " << (g_tcp ? s.mss() : s.maxDatagramPayload()) << " bytes" << std::endl;
+    std::cout << "  Segments: " << batch.count() << std::endl;
+    std::cout << "\nPhysical Layer:" << std::endl;
+    std::cout << "  Saved to file: " << filename << std::endl;
+    std::cout << "  Frames written: " << writer.framesWritten() << std::endl;
     
     std::cout << std::endl << "Encapsulation complete!" << std::endl;
 }
 
+void runShmSender(const std::string& message, const std::string& address, uint64_t count) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Encapsulation Module (Sender)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    io::ShmRingWriter writer(io::parseShmAddress(address));
+    std::cout << "Shared memory ring: " << address << " (" << writer.slots() << " slots of "
+              << writer.slotSize() << " bytes)" << std::endl;
+    
+    sender::Sender s(senderConfig());
+    configureTracer(s.tracer(), trace::Level::Off);
+    application::Data appData(message);
+    
+    // 每帧直接封装进共享内存槽位
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i) {
+        s.send(appData, writer);
+    }
+    writer.close();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << "Frames sent: " << writer.framesWritten() << std::endl;
+    std::cout << "Sender sleeps: " << writer.sleeps() << std::endl;
+    if (elapsed.count() > 0) {
+        std::cout << "Throughput: " << (writer.framesWritten() / elapsed.count() / 1e6) << " Mpps" << std::endl;
+    }
+    std::cout << std::endl << "Encapsulation complete!" << std::endl;
+}
+
+void runSocketSender(const std::string& message, const std::string& address, uint64_t count) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Encapsulation Module (Sender)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    io::SocketConfig socketConfig = io::parseSocketAddress(address, g_socketConfig);
+    std::cout << "Sending to: " << socketConfig.host << ":" << socketConfig.port
+              << " (batch " << socketConfig.batchSize << ")" << std::endl;
+    
+    sender::Sender s(senderConfig());
+    configureTracer(s.tracer(), trace::Level::Off);
+    io::SocketWriter writer(socketConfig);
+    
+    // 一整批帧只封装一次，之后每次sendmmsg直接引用批内存
+    std::vector<application::Data> batch(std::min<uint64_t>(count, socketConfig.batchSize),
+                                         application::Data(message));
+    auto frames = s.encapsulateBatch(batch);
+    
+    auto start = std::chrono::steady_clock::now();
+    uint64_t remaining = count;
+    while (remaining >= frames.count() && !frames.empty()) {
+        writer.write(frames);
+        remaining -= frames.count();
+    }
+    for (uint64_t i = 0; i < remaining; ++i) {
+        writer.write(frames.frame(0));
+    }
+    writer.flush();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << "Frames sent: " << writer.framesSent() << std::endl;
+    std::cout << "sendmmsg calls: " << writer.syscalls() << std::endl;
+    if (elapsed.count() > 0) {
+        std::cout << "Throughput: " << (writer.framesSent() / elapsed.count() / 1e6) << " Mpps" << std::endl;
+    }
+    std::cout << std::endl << "Encapsulation complete!" << std::endl;
+}
+
+// 输出协议分发统计
+void printDemuxStats(const demux::DemuxStats& stats) {
+    std::cout << "  Protocols: arp " << stats.arp << ", ipv4 " << stats.ipv4 << ", ipv6 " << stats.ipv6
+              << ", vlan " << stats.vlan << ", udp " << stats.udp << ", tcp " << stats.tcp
+              << ", icmp " << stats.icmp << std::endl;
+    std::cout << "  Unknown EtherType " << stats.unknownEtherType << ", unknown IP protocol "
+              << stats.unknownProtocol << ", malformed " << stats.malformed << std::endl;
+}
+
+// 输出解封装失败的原因明细（只列出非零项）
+void printDropReasons(const common::DropCounters& drops) {
+    std::cout << "  Drop reasons:";
+    const char* separator = " ";
+    for (size_t i = 1; i < common::DECODE_STATUS_COUNT; ++i) {
+        auto status = static_cast<common::DecodeStatus>(i);
+        if (drops[status] > 0) {
+            std::cout << separator << common::decodeStatusName(status) << " " << drops[status];
+            separator = ", ";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 从流式输入后端解封装直到输入结束，输出统计
+void runStreamReceiver(io::FrameReader& reader) {
+    receiver::Receiver r(g_receiverOptions);
+    configureTracer(r.tracer(), trace::Level::Off);
+    auto flows = openFlowRecorder();
+    std::string firstMessage;
+    bool haveFirst = false;
+    
+    // 计时从首帧开始，并扣除结尾的空闲等待
+    std::chrono::steady_clock::time_point first;
+    std::chrono::steady_clock::time_point last;
+    auto stats = r.decapsulateStream(reader, [&](const receiver::PacketView& packet) {
+        last = std::chrono::steady_clock::now();
+        if (!haveFirst) {
+            first = last;
+            firstMessage = packet.payload.toString();
+            haveFirst = true;
+        }
+        if (flows) {
+            flows->record(packet);
+        }
+    });
+    std::chrono::duration<double> elapsed = last - first;
+    
+    std::cout << std::endl << "========================================" << std::endl;
+    std::cout << "       Decapsulation Result Summary" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Frames received: " << stats.frames << " (" << stats.bytes << " bytes)" << std::endl;
+    std::cout << "Frames decapsulated: " << stats.decoded << std::endl;
+    std::cout << "Frames rejected: " << stats.errors << std::endl;
+    if (stats.errors > 0) {
+        printDropReasons(r.drops());
+    }
+    if (!g_receiverOptions.filter.empty()) {
+        std::cout << "Frames filtered: " << stats.filtered << std::endl;
+    }
+    if (stats.skipped > 0) {
+        std::cout << "Frames skipped (not IP/UDP): " << stats.skipped << std::endl;
+        printDemuxStats(r.demux().stats());
+    }
+    if (elapsed.count() > 0) {
+        std::cout << "Throughput: " << (stats.decoded / elapsed.count() / 1e6) << " Mpps" << std::endl;
+    }
+    if (haveFirst) {
+        std::cout << "First message: " << firstMessage << std::endl;
+    }
+    if (flows) {
+        flows->finish();
+    }
+}
+
+void runSocketReceiver(const std::string& address) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Decapsulation Module (Receiver)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    io::SocketConfig socketConfig = io::parseSocketAddress(address, g_socketConfig);
+    io::SocketReader reader(socketConfig);
+    std::cout << "Listening on: " << socketConfig.host << ":" << socketConfig.port
+              << (socketConfig.busyPoll ? " (busy-poll)" : "") << std::endl;
+    
+    runStreamReceiver(reader);
+    std::cout << "recvmmsg calls: " << reader.syscalls() << std::endl;
+}
+
+void runShmReceiver(const std::string& address) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Decapsulation Module (Receiver)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    io::ShmRingReader reader(io::parseShmAddress(address));
+    std::cout << "Shared memory ring: " << address << " (" << reader.slots() << " slots of "
+              << reader.slotSize() << " bytes)" << std::endl;
+    
+    runStreamReceiver(reader);
+    std::cout << "Receiver sleeps: " << reader.sleeps() << std::endl;
+}
+
+void runCaptureReceiver(const std::string& filename) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Decapsulation Module (Receiver)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    std::cout << "Reading capture: " << filename << std::endl;
+    
+    receiver::Receiver r(g_receiverOptions);
+    configureTracer(r.tracer(), trace::Level::Off);
+    auto flows = openFlowRecorder();
+    std::string firstMessage;
+    bool haveFirst = false;
+    
+    auto start = std::chrono::steady_clock::now();
+    auto stats = r.decapsulateCapture(filename, [&](const receiver::PacketView& packet) {
+        if (!haveFirst) {
+            firstMessage = packet.payload.toString();
+            haveFirst = true;
+        }
+        if (flows) {
+            flows->record(packet);
+        }
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << std::endl << "========================================" << std::endl;
+    std::cout << "       Decapsulation Result Summary" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Frames read: " << stats.frames << " (" << stats.bytes << " bytes)" << std::endl;
+    std::cout << "Frames decapsulated: " << stats.decoded << std::endl;
+    std::cout << "Frames rejected: " << stats.errors << std::endl;
+    if (stats.errors > 0) {
+        printDropReasons(r.drops());
+    }
+    if (!g_receiverOptions.filter.empty()) {
+        std::cout << "Frames filtered: " << stats.filtered << std::endl;
+    }
+    if (stats.skipped > 0) {
+        std::cout << "Frames skipped (not IP/UDP): " << stats.skipped << std::endl;
+        printDemuxStats(r.demux().stats());
+    }
+    if (elapsed.count() > 0) {
+        std::cout << "Throughput: " << (stats.frames / elapsed.count() / 1e6) << " Mpps" << std::endl;
+    }
+    if (haveFirst) {
+        std::cout << "First message: " << firstMessage << std::endl;
+    }
+    if (flows) {
+        flows->finish();
+    }
+}
+
+void runPipelineReceiver(const std::string& filename) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Decapsulation Module (Receive Pipeline)" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    std::cout << "Reading capture: " << filename << std::endl;
+    std::cout << "Workers: " << g_workers << (g_pinCores ? " (pinned)" : "") << std::endl;
+    
+    receiver::PipelineConfig config;
+    config.workers = g_workers;
+    config.pinCores = g_pinCores;
+    config.receiver = g_receiverOptions;
+    receiver::ReceivePipeline pipeline(config, nullptr);
+    
+    // 帧直接指向mmap映射的文件内容，读取器须在流水线停止后才能析构
+    io::PcapReader reader(filename);
+    io::PcapRecord record;
+    uint64_t frames = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    pipeline.start();
+    while (reader.next(record)) {
+        pipeline.dispatch(record.data);
+        ++frames;
+    }
+    pipeline.stop();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << std::endl << "========================================" << std::endl;
+    std::cout << "       Decapsulation Result Summary" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Frames read: " << frames << std::endl;
+    std::cout << "Dispatcher stalls: " << pipeline.dispatchStalls() << std::endl;
+    auto stats = pipeline.stats();
+    common::DropCounters drops;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << "  Worker " << i << ": " << stats[i].packets << " packets, "
+                  << stats[i].errors << " rejected, " << stats[i].filtered << " filtered, "
+                  << stats[i].skipped << " skipped, "
+                  << stats[i].mpps() << " Mpps" << std::endl;
+        drops += stats[i].drops;
+    }
+    if (drops.total() > 0) {
+        printDropReasons(drops);
+    }
+    if (elapsed.count() > 0) {
+        std::cout << "Throughput: " << (frames / elapsed.count() / 1e6) << " Mpps" << std::endl;
+    }
+}
+
 void runReceiver(const std::string& filename) {
     std::cout << "========================================" << std::endl;
     std::cout << "       Decapsulation Module (Receiver)" << std::endl;
     std::cout << "========================================" << std::endl << std::endl;
     
-    receiver::Receiver r;
+    receiver::Receiver r(g_receiverOptions);
+    configureTracer(r.tracer(), trace::Level::Detail);
     auto parsed = r.decapsulateFromFile(filename);
     
     std::cout << std::endl << "========================================" << std::endl;
     std::cout << "       Decapsulation Result Summary" << std::endl;
     std::cout << "========================================" << std::endl;
-    std::cout << "Original message: " << parsed.applicationData->getPayloadString() << std::endl;
+    std::cout << "Original message: " << parsed.applicationData().getPayloadString() << std::endl;
+}
+
+void runFilter(const std::string& input, const std::string& output) {
+    std::cout << "Filter: " << g_receiverOptions.filter.expression() << std::endl;
+    std::cout << g_receiverOptions.filter.dump();
+    
+    io::PcapReader reader(input);
+    io::PcapWriter writer(output);
+    io::PcapRecord record;
+    uint64_t frames = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(record)) {
+        ++frames;
+        if (g_receiverOptions.filter.matches(record.data)) {
+            writer.write(record.data, record.timestampNs);
+        }
+    }
+    writer.close();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << "Frames read: " << frames << std::endl;
+    std::cout << "Frames matched: " << writer.framesWritten() << " (written to " << output << ")" << std::endl;
+    if (frames > 0) {
+        std::cout << "Time per frame: " << (elapsed.count() / frames) << " ns" << std::endl;
+    }
+}
+
+// 解析数值选项的取值（1到max之间的十进制整数），非法时抛出异常
+uint64_t parseCountOption(const std::string& option, const std::string& value,
+                          uint64_t max = 999999999) {
+    uint64_t result = 0;
+    bool valid = !value.empty();
+    for (char c : value) {
+        uint64_t digit = static_cast<uint64_t>(c - '0');
+        if (c < '0' || c > '9' || result > (max - digit) / 10) {
+            valid = false;
+            break;
+        }
+        result = result * 10 + digit;
+    }
+    if (!valid || result == 0) {
+        throw std::runtime_error("Invalid value for " + option + ": '" + value + "' (expected 1-" +
+                                 std::to_string(max) + ")");
+    }
+    return result;
+}
+
+generator::GeneratorConfig parseGeneratorOptions() {
+    generator::GeneratorConfig config;
+    for (const auto& arg : g_generatorArgs) {
+        size_t eq = arg.find('=');
+        std::string name = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+        if (name == "count") {
+            config.packets = parseCountOption("--count", value, UINT64_MAX);
+        } else if (name == "flow-count") {
+            config.flows = static_cast<size_t>(parseCountOption("--flow-count", value, generator::MAX_FLOWS));
+        } else if (name == "src-ip") {
+            config.srcIP = generator::parseAddressRange(value);
+        } else if (name == "dst-ip") {
+            config.dstIP = generator::parseAddressRange(value);
+        } else if (name == "src-port") {
+            config.srcPort = generator::parsePortRange(value);
+        } else if (name == "dst-port") {
+            config.dstPort = generator::parsePortRange(value);
+        } else if (name == "size") {
+            generator::parseSizeSpec(value, config);
+        }
+    }
+    return config;
+}
+
+void printGeneratorStats(const generator::GeneratorStats& stats) {
+    std::cout << "Packets generated: " << stats.packets << " (" << stats.bytes << " bytes)" << std::endl;
+    std::cout << "Throughput: " << stats.mpps() << " Mpps (" << stats.gbps() << " Gbps)" << std::endl;
+}
+
+void runGenerator(const std::string& output) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Traffic Generator" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    auto config = parseGeneratorOptions();
+    generator::Generator gen(config);
+    static const char* const SIZE_MODES[] = {"fixed", "uniform", "imix"};
+    std::cout << "Flow templates: " << gen.flowCount() << std::endl;
+    std::cout << "Payload sizes: " << SIZE_MODES[static_cast<int>(config.sizeMode)];
+    if (config.sizeMode != generator::SizeMode::Imix) {
+        std::cout << " " << config.minPayload << "-" << config.maxPayload << " bytes";
+    }
+    std::cout << std::endl << "Output: " << output << std::endl << std::endl;
+    
+    if (output != "pipeline") {
+        std::unique_ptr<io::FrameWriter> writer;
+        if (io::isSocketAddress(output)) {
+            writer.reset(new io::SocketWriter(io::parseSocketAddress(output, g_socketConfig)));
+        } else if (io::isShmAddress(output)) {
+            writer.reset(new io::ShmRingWriter(io::parseShmAddress(output)));
+        } else if (io::isPcapFile(output)) {
+            writer.reset(new io::PcapWriter(output));
+        } else {
+            throw std::runtime_error("Unsupported generator output: " + output);
+        }
+        printGeneratorStats(gen.run(*writer));
+        return;
+    }
+    
+    receiver::PipelineConfig pipelineConfig;
+    pipelineConfig.workers = g_workers;
+    pipelineConfig.pinCores = g_pinCores;
+    pipelineConfig.receiver = g_receiverOptions;
+    receiver::ReceivePipeline pipeline(pipelineConfig, nullptr);
+    
+    // 双缓冲：生成一批的同时工作线程处理上一批，分发前确认上一批已处理完，
+    // 下一次写入本缓冲区时它早已不再被引用
+    common::FrameBatch batches[2];
+    size_t current = 0;
+    generator::GeneratorStats stats;
+    auto start = std::chrono::steady_clock::now();
+    pipeline.start();
+    while (gen.nextBatch(batches[current]) > 0) {
+        pipeline.wait();
+        for (size_t i = 0; i < batches[current].count(); ++i) {
+            pipeline.dispatch(batches[current].frame(i));
+        }
+        stats.packets += batches[current].count();
+        stats.bytes += batches[current].bytes();
+        current ^= 1;
+    }
+    pipeline.stop();
+    stats.elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    
+    printGeneratorStats(stats);
+    uint64_t decoded = 0;
+    for (const auto& worker : pipeline.stats()) {
+        decoded += worker.packets;
+    }
+    std::cout << "Decapsulated by " << pipeline.workerCount() << " worker(s): " << decoded << std::endl;
+}
+
+void runPacer(const std::string& output) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "       Rate-Paced Sender" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    // 流模板与生成器相同，每条流使用固定载荷（--size取下限）
+    auto config = parseGeneratorOptions();
+    generator::Generator gen(config);
+    sender::FlowRate rate = sender::parseRate(g_rate);
+    rate.burst = g_burst;
+    rate.rate /= static_cast<double>(gen.flowCount());
+    
+    sender::Pacer pacer;
+    application::Data payload(std::string(config.minPayload, 'x'));
+    for (size_t i = 0; i < gen.flowCount(); ++i) {
+        sender::Sender s(gen.flowConfig(i));
+        pacer.addFlow(s.encapsulate(payload), rate);
+    }
+    
+    const auto& clock = common::TscClock::instance();
+    std::cout << "Flows: " << pacer.flowCount() << ", rate " << g_rate << ", burst " << g_burst << std::endl;
+    std::cout << "Clock: ";
+    if (clock.usingTsc()) {
+        std::cout << "TSC " << clock.ghz() << " GHz" << std::endl;
+    } else {
+        std::cout << "steady_clock" << std::endl;
+    }
+    std::cout << "Output: " << output << std::endl << std::endl;
+    
+    std::unique_ptr<io::FrameWriter> writer;
+    if (output == "null") {
+        writer.reset(new io::NullWriter());
+    } else if (io::isSocketAddress(output)) {
+        writer.reset(new io::SocketWriter(io::parseSocketAddress(output, g_socketConfig)));
+    } else if (io::isShmAddress(output)) {
+        writer.reset(new io::ShmRingWriter(io::parseShmAddress(output)));
+    } else if (io::isPcapFile(output)) {
+        writer.reset(new io::PcapWriter(output));
+    } else {
+        throw std::runtime_error("Unsupported pacer output: " + output);
+    }
+    auto stats = pacer.run(*writer, config.packets);
+    writer->flush();
+    
+    std::cout << "Packets sent: " << stats.packets << " (" << stats.bytes << " bytes) in "
+              << stats.rounds << " rounds" << std::endl;
+    std::cout << "Requested rate: " << stats.requestedPps << " pps" << std::endl;
+    std::cout << "Achieved rate:  " << stats.achievedPps() << " pps (" << stats.gbps() << " Gbps)" << std::endl;
+    if (!stats.rateWithin()) {
+        std::cout << "Warning: achieved rate is off the requested rate by more than "
+                  << sender::RATE_TOLERANCE * 100 << "%" << std::endl;
+    }
+    
+    constexpr size_t MAX_LISTED_FLOWS = 8;
+    for (size_t i = 0; i < stats.flows.size() && i < MAX_LISTED_FLOWS; ++i) {
+        const auto& flow = stats.flows[i];
+        std::cout << "Flow " << i << ": " << flow.packets << " packets, " << flow.achievedPps
+                  << "/" << flow.requestedPps << " pps, interval " << flow.meanIntervalNs
+                  << " ns (ideal " << flow.idealIntervalNs << "), jitter " << flow.jitterNs
+                  << " ns, max deviation " << flow.maxDeviationNs << " ns" << std::endl;
+    }
+    if (stats.flows.size() > MAX_LISTED_FLOWS) {
+        std::cout << "... " << (stats.flows.size() - MAX_LISTED_FLOWS) << " more flow(s)" << std::endl;
+    }
 }
 
 void runDemo(const std::string& message) {
@@ -58,8 +769,9 @@ void runDemo(const std::string& message) {
     
     application::Data appData(message);
     
-    auto config = sender::Sender::defaultConfig();
+    auto config = senderConfig();
     sender::Sender s(config);
+    configureTracer(s.tracer(), trace::Level::Detail);
     
     s.encapsulateAndSave(appData, DEFAULT_FILENAME);
     
@@ -68,7 +780,8 @@ void runDemo(const std::string& message) {
     std::cout << "         Part 2: Decapsulation" << std::endl;
     std::cout << "========================================" << std::endl << std::endl;
     
-    receiver::Receiver r;
+    receiver::Receiver r(g_receiverOptions);
+    configureTracer(r.tracer(), trace::Level::Detail);
     auto parsed = r.decapsulateFromFile(DEFAULT_FILENAME);
     
     // Verification
@@ -76,9 +789,9 @@ void runDemo(const std::string& message) {
     std::cout << "         Verification Result" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Original sent message: " << message << std::endl;
-    std::cout << "Decapsulated message:  " << parsed.applicationData->getPayloadString() << std::endl;
+    std::cout << "Decapsulated message:  " << parsed.applicationData().getPayloadString() << std::endl;
     
-    if (message == parsed.applicationData->getPayloadString()) {
+    if (message == parsed.applicationData().getPayloadString()) {
         std::cout << "Verification SUCCESS: Messages match!" << std::endl;
     } else {
         std::cout << "Verification FAILED: Messages don't match!" << std::endl;
@@ -86,20 +799,93 @@ void runDemo(const std::string& message) {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        printUsage();
-        return 0;
-    }
-    
-    std::string command = argv[1];
-    std::string message = (argc > 2) ? argv[2] : DEFAULT_MESSAGE;
-    
     try {
+        // 分离选项与位置参数
+        std::vector<std::string> args;
+        const std::string traceOption = "--trace=";
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, traceOption.size(), traceOption) == 0) {
+                g_traceMode = arg.substr(traceOption.size());
+            } else if (arg == "--ipv6") {
+                g_ipv6 = true;
+            } else if (arg == "--tcp") {
+                g_tcp = true;
+            } else if (arg == "--gso") {
+                g_gso = true;
+            } else if (arg == "--no-verify") {
+                g_receiverOptions.verifyChecksums = false;
+            } else if (arg.compare(0, 10, "--workers=") == 0) {
+                g_workers = parseCountOption("--workers", arg.substr(10));
+            } else if (arg == "--pin") {
+                g_pinCores = true;
+            } else if (arg.compare(0, 8, "--batch=") == 0) {
+                g_socketConfig.batchSize = parseCountOption("--batch", arg.substr(8));
+            } else if (arg == "--busy-poll") {
+                g_socketConfig.busyPoll = true;
+            } else if (arg.compare(0, 8, "--count=") == 0 || arg.compare(0, 13, "--flow-count=") == 0 ||
+                       arg.compare(0, 9, "--src-ip=") == 0 || arg.compare(0, 9, "--dst-ip=") == 0 ||
+                       arg.compare(0, 11, "--src-port=") == 0 || arg.compare(0, 11, "--dst-port=") == 0 ||
+                       arg.compare(0, 7, "--size=") == 0) {
+                g_generatorArgs.push_back(arg);
+            } else if (arg.compare(0, 7, "--rate=") == 0) {
+                g_rate = arg.substr(7);
+            } else if (arg.compare(0, 8, "--burst=") == 0) {
+                g_burst = parseCountOption("--burst", arg.substr(8));
+            } else if (arg.compare(0, 9, "--filter=") == 0) {
+                g_filterExpression = arg.substr(9);
+            } else if (arg.compare(0, 8, "--flows=") == 0) {
+                g_flowFile = arg.substr(8);
+            } else {
+                args.push_back(arg);
+            }
+        }
+        
+        if (args.empty()) {
+            printUsage();
+            return 0;
+        }
+        
+        std::string command = args[0];
+        std::string message = (args.size() > 1) ? args[1] : DEFAULT_MESSAGE;
+        
+        g_receiverOptions.filter = filter::Filter::compile(g_filterExpression);
+        
         if (command == "send") {
-            runSender(message);
+            std::string filename = (args.size() > 2) ? args[2] : DEFAULT_FILENAME;
+            uint64_t count = (args.size() > 3) ? parseCountOption("count", args[3], UINT64_MAX) : 1;
+            if (io::isSocketAddress(filename)) {
+                runSocketSender(message, filename, count);
+            } else if (io::isShmAddress(filename)) {
+                runShmSender(message, filename, count);
+            } else if (g_tcp || g_gso) {
+                runSegmentSender(message, filename, count);
+            } else {
+                runSender(message, filename, count);
+            }
         } else if (command == "receive") {
-            std::string filename = (argc > 2) ? argv[2] : DEFAULT_FILENAME;
-            runReceiver(filename);
+            std::string filename = (args.size() > 1) ? args[1] : DEFAULT_FILENAME;
+            if (io::isSocketAddress(filename)) {
+                runSocketReceiver(filename);
+            } else if (io::isShmAddress(filename)) {
+                runShmReceiver(filename);
+            } else if (io::isPcapFile(filename) && g_workers > 1) {
+                runPipelineReceiver(filename);
+            } else if (io::isPcapFile(filename)) {
+                runCaptureReceiver(filename);
+            } else {
+                runReceiver(filename);
+            }
+        } else if (command == "gen") {
+            runGenerator(args.size() > 1 ? args[1] : "pipeline");
+        } else if (command == "pace") {
+            runPacer(args.size() > 1 ? args[1] : "null");
+        } else if (command == "filter") {
+            if (args.size() < 3) {
+                printUsage();
+                return 1;
+            }
+            runFilter(args[1], args[2]);
         } else if (command == "demo") {
             runDemo(message);
         } else {
@@ -0,0 +1,273 @@
+#include "network/fragment.h"
+#include "common/hash.h"
+#include "common/checksum.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+namespace network {
+
+namespace {
+
+uint32_t loadAddress(const IPv4Address& ip) {
+    return common::loadBE32(ip.data());
+}
+
+uint32_t randomSeed() {
+    std::random_device rd;
+    return rd();
+}
+
+} // namespace
+
+IdGenerator::IdGenerator() : seed_(randomSeed()) {
+    for (auto& counter : counters_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint16_t IdGenerator::next(const IPv4Address& srcIP, const IPv4Address& dstIP, uint8_t protocol) {
+    uint64_t h = common::mix64((static_cast<uint64_t>(loadAddress(srcIP)) << 32) ^ loadAddress(dstIP) ^
+                               (static_cast<uint64_t>(protocol) << 24) ^ seed_);
+    auto& counter = counters_[h % BUCKETS];
+    // 每个桶的起点随散列值偏移，使不同流的标识序列互不相关
+    return static_cast<uint16_t>(counter.fetch_add(1, std::memory_order_relaxed) + (h >> 48));
+}
+
+IdGenerator& IdGenerator::global() {
+    static IdGenerator generator;
+    return generator;
+}
+
+Reassembler::Reassembler(const ReassemblyConfig& config)
+    : config_(config), slotBytes_(IPV4_MAX_HEADER_SIZE + config.maxDatagramSize),
+      tableMask_(0), oldest_(NONE), newest_(NONE), used_(0) {
+    if (config_.maxDatagrams == 0) {
+        throw std::runtime_error("Reassembler needs at least one slot");
+    }
+    
+    buffers_.resize(config_.maxDatagrams * slotBytes_);
+    slots_.resize(config_.maxDatagrams);
+    freeSlots_.reserve(config_.maxDatagrams);
+    for (size_t i = config_.maxDatagrams; i > 0; --i) {
+        freeSlots_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    
+    // 散列表大小取不小于槽位数两倍的2的幂，保证负载因子不超过0.5
+    size_t tableSize = 1;
+    while (tableSize < config_.maxDatagrams * 2) {
+        tableSize <<= 1;
+    }
+    table_.assign(tableSize, NONE);
+    tableMask_ = tableSize - 1;
+}
+
+bool Reassembler::add(const IPv4View& fragment, uint64_t nowNs, common::ByteView& datagram) {
+    ++stats_.fragments;
+    expire(nowNs);
+    
+    common::ByteView payload = fragment.payload();
+    bool moreFragments = (fragment.flags() & IPV4_FLAG_MF) != 0;
+    uint32_t first = static_cast<uint32_t>(fragment.fragmentOffset()) * 8;
+    size_t len = payload.size();
+    if (len == 0 || (moreFragments && len % 8 != 0) || first + len > config_.maxDatagramSize) {
+        ++stats_.invalid;
+        return false;
+    }
+    uint32_t last = first + static_cast<uint32_t>(len) - 1;
+    
+    Key key;
+    key.srcIP = fragment.srcIP();
+    key.dstIP = fragment.dstIP();
+    key.identification = fragment.identification();
+    key.protocol = fragment.protocol();
+    
+    uint32_t index = find(key);
+    if (index == NONE) {
+        index = allocate(key, nowNs);
+    }
+    Slot& slot = slots_[index];
+    
+    // 与已知总长度矛盾的分片直接丢弃
+    if (slot.totalLength != NONE &&
+        (last >= slot.totalLength || (!moreFragments && last + 1 != slot.totalLength))) {
+        ++stats_.invalid;
+        return false;
+    }
+    
+    if (!fillHole(slot, first, last, moreFragments)) {
+        ++stats_.tooManyHoles;
+        release(index);
+        return false;
+    }
+    
+    uint8_t* buffer = slotBuffer(index);
+    std::memcpy(buffer + IPV4_MAX_HEADER_SIZE + first, payload.data(), len);
+    if (first == 0) {
+        slot.headerLength = static_cast<uint32_t>(fragment.headerLength());
+        std::memcpy(buffer + IPV4_MAX_HEADER_SIZE - slot.headerLength,
+                    fragment.bytes().data(), slot.headerLength);
+    }
+    
+    if (slot.holeCount > 0) {
+        return false;
+    }
+    
+    // 全部到齐：在载荷前放置首部，清除分片字段并重算校验和
+    size_t totalLength = slot.headerLength + slot.totalLength;
+    if (totalLength > IPV4_MAX_PACKET_SIZE) {
+        ++stats_.invalid;
+        release(index);
+        return false;
+    }
+    uint8_t* header = buffer + IPV4_MAX_HEADER_SIZE - slot.headerLength;
+    fields::TotalLength::set(header, static_cast<uint16_t>(totalLength));
+    fields::Flags::set(header, fields::Flags::get(header) & IPV4_FLAG_DF);
+    fields::FragmentOffset::set(header, 0);
+    fields::HeaderChecksum::set(header, 0);
+    fields::HeaderChecksum::set(header, common::checksum(header, slot.headerLength));
+    
+    datagram = common::ByteView(header, totalLength);
+    ++stats_.completed;
+    release(index);
+    return true;
+}
+
+void Reassembler::expire(uint64_t nowNs) {
+    // 链表按到达顺序排列，只需检查表头
+    while (oldest_ != NONE && nowNs - slots_[oldest_].firstSeenNs > config_.timeoutNs) {
+        ++stats_.timedOut;
+        release(oldest_);
+    }
+}
+
+bool Reassembler::fillHole(Slot& slot, uint32_t first, uint32_t last, bool moreFragments) {
+    // RFC 815：用新分片切分与之重叠的空洞
+    std::array<Hole, MAX_HOLES> holes;
+    size_t count = 0;
+    for (uint8_t i = 0; i < slot.holeCount; ++i) {
+        Hole hole = slot.holes[i];
+        if (first > hole.last || last < hole.first) {
+            if (!moreFragments && hole.first > last) {
+                continue;  // 最后一个分片之后不再有数据
+            }
+            if (count == MAX_HOLES) {
+                return false;
+            }
+            holes[count++] = hole;
+            continue;
+        }
+        if (first > hole.first) {
+            if (count == MAX_HOLES) {
+                return false;
+            }
+            holes[count++] = Hole{hole.first, first - 1};
+        }
+        if (last < hole.last && moreFragments) {
+            if (count == MAX_HOLES) {
+                return false;
+            }
+            holes[count++] = Hole{last + 1, hole.last};
+        }
+    }
+    
+    if (!moreFragments) {
+        slot.totalLength = last + 1;
+    }
+    slot.holes = holes;
+    slot.holeCount = static_cast<uint8_t>(count);
+    return true;
+}
+
+size_t Reassembler::hashKey(const Key& key) const {
+    uint64_t h = (static_cast<uint64_t>(loadAddress(key.srcIP)) << 32) | loadAddress(key.dstIP);
+    h ^= common::mix64((static_cast<uint64_t>(key.identification) << 8) | key.protocol);
+    return static_cast<size_t>(common::mix64(h));
+}
+
+uint32_t Reassembler::find(const Key& key) const {
+    for (size_t i = hashKey(key) & tableMask_;; i = (i + 1) & tableMask_) {
+        uint32_t slot = table_[i];
+        if (slot == NONE) {
+            return NONE;
+        }
+        if (slots_[slot].key == key) {
+            return slot;
+        }
+    }
+}
+
+uint32_t Reassembler::allocate(const Key& key, uint64_t nowNs) {
+    if (freeSlots_.empty()) {
+        // 内存上限已到：挤出最早的数据报
+        ++stats_.evicted;
+        release(oldest_);
+    }
+    uint32_t index = freeSlots_.back();
+    freeSlots_.pop_back();
+    ++used_;
+    
+    Slot& slot = slots_[index];
+    slot.key = key;
+    slot.firstSeenNs = nowNs;
+    slot.totalLength = NONE;
+    slot.headerLength = 0;
+    slot.holes[0] = Hole{0, INFINITE_OFFSET};
+    slot.holeCount = 1;
+    
+    slot.prev = newest_;
+    slot.next = NONE;
+    if (newest_ != NONE) {
+        slots_[newest_].next = index;
+    } else {
+        oldest_ = index;
+    }
+    newest_ = index;
+    
+    size_t i = hashKey(key) & tableMask_;
+    while (table_[i] != NONE) {
+        i = (i + 1) & tableMask_;
+    }
+    table_[i] = index;
+    slot.tableIndex = static_cast<uint32_t>(i);
+    return index;
+}
+
+void Reassembler::release(uint32_t index) {
+    Slot& slot = slots_[index];
+    tableErase(slot.tableIndex);
+    
+    if (slot.prev != NONE) {
+        slots_[slot.prev].next = slot.next;
+    } else {
+        oldest_ = slot.next;
+    }
+    if (slot.next != NONE) {
+        slots_[slot.next].prev = slot.prev;
+    } else {
+        newest_ = slot.prev;
+    }
+    
+    freeSlots_.push_back(index);
+    --used_;
+}
+
+void Reassembler::tableErase(uint32_t index) {
+    // 线性探测的向后移位删除，不留墓碑
+    size_t hole = index;
+    table_[hole] = NONE;
+    for (size_t j = (hole + 1) & tableMask_; table_[j] != NONE; j = (j + 1) & tableMask_) {
+        size_t ideal = hashKey(slots_[table_[j]].key) & tableMask_;
+        bool stays = (hole <= j) ? (hole < ideal && ideal <= j) : (hole < ideal || ideal <= j);
+        if (stays) {
+            continue;
+        }
+        table_[hole] = table_[j];
+        slots_[table_[hole]].tableIndex = static_cast<uint32_t>(hole);
+        table_[j] = NONE;
+        hole = j;
+    }
+}
+
+} // namespace network
@@ -1,4 +1,5 @@
 #include "network/ipv4.h"
+#include "common/checksum.h"
 #include <sstream>
 #include <iomanip>
 #include <cstring>
@@ -22,6 +23,14 @@ IPv4Packet::IPv4Packet(const IPv4Address& srcIP, const IPv4Address& dstIP,
     header_.dstIP = dstIP;
 }
 
+IPv4Packet::IPv4Packet(const IPv4View& view)
+    : header_(view.header()), payload_(view.payload()) {
+}
+
+IPv4Packet::IPv4Packet(const IPv4View& view, common::ByteStorage payload)
+    : header_(view.header()), payload_(std::move(payload)) {
+}
+
 IPv4Packet IPv4Packet::createUDP(const IPv4Address& srcIP, const IPv4Address& dstIP,
                                    const std::vector<uint8_t>& payload) {
     return IPv4Packet(srcIP, dstIP, PROTOCOL_UDP, payload);
@@ -30,105 +39,97 @@ IPv4Packet IPv4Packet::createUDP(const IPv4Address& srcIP, const IPv4Address& ds
 std::vector<uint8_t> IPv4Packet::encode() const {
     std::vector<uint8_t> buf(IPV4_HEADER_SIZE + payload_.size());
     
-    // 版本和首部长度
-    buf[0] = (header_.version << 4) | (header_.ihl & 0x0F);
-    // TOS
-    buf[1] = header_.tos;
-    // 总长度
-    buf[2] = (header_.totalLength >> 8) & 0xFF;
-    buf[3] = header_.totalLength & 0xFF;
-    // 标识
-    buf[4] = (header_.identification >> 8) & 0xFF;
-    buf[5] = header_.identification & 0xFF;
-    // 标志和片偏移
-    uint16_t flagsFragOffset = (static_cast<uint16_t>(header_.flags) << 13) | 
-                                (header_.fragmentOffset & 0x1FFF);
-    buf[6] = (flagsFragOffset >> 8) & 0xFF;
-    buf[7] = flagsFragOffset & 0xFF;
-    // TTL
-    buf[8] = header_.ttl;
-    // 协议
-    buf[9] = header_.protocol;
-    // 首部校验和（先置0）
-    buf[10] = 0;
-    buf[11] = 0;
-    // 源IP地址
-    std::copy(header_.srcIP.begin(), header_.srcIP.end(), buf.begin() + 12);
-    // 目的IP地址
-    std::copy(header_.dstIP.begin(), header_.dstIP.end(), buf.begin() + 16);
-    
-    // 计算首部校验和
-    std::vector<uint8_t> headerBuf(buf.begin(), buf.begin() + IPV4_HEADER_SIZE);
-    uint16_t checksum = calculateChecksum(headerBuf);
-    buf[10] = (checksum >> 8) & 0xFF;
-    buf[11] = checksum & 0xFF;
+    encodeHeader(header_, buf.data());
     
     // 写入数据
-    std::copy(payload_.begin(), payload_.end(), buf.begin() + IPV4_HEADER_SIZE);
+    common::ByteView payload = payload_.view();
+    std::copy(payload.begin(), payload.end(), buf.begin() + IPV4_HEADER_SIZE);
     
     return buf;
 }
 
-uint16_t IPv4Packet::calculateChecksum(const std::vector<uint8_t>& header) {
-    uint32_t sum = 0;
-    for (size_t i = 0; i < header.size(); i += 2) {
-        uint16_t word = (static_cast<uint16_t>(header[i]) << 8);
-        if (i + 1 < header.size()) {
-            word |= header[i + 1];
-        }
-        sum += word;
+void IPv4Packet::encodeHeader(const IPv4Header& header, uint8_t* out) {
+    // 校验和字段先置0写入，再按整个首部计算
+    IPv4Header zeroed = header;
+    zeroed.headerChecksum = 0;
+    fields::IPv4Codec::encode(zeroed, out);
+    fields::HeaderChecksum::set(out, common::checksum(out, IPV4_HEADER_SIZE));
+}
+
+void IPv4Packet::prependHeader(common::PacketBuffer& buf, const IPv4Address& srcIP,
+                               const IPv4Address& dstIP, uint8_t protocol) {
+    size_t totalLength = IPV4_HEADER_SIZE + buf.size();
+    if (totalLength > 0xFFFF) {
+        throw std::runtime_error("Payload too large for IPv4 packet");
+    }
+    
+    IPv4Header header{};
+    header.version = 4;
+    header.ihl = 5;
+    header.totalLength = static_cast<uint16_t>(totalLength);
+    header.ttl = DEFAULT_TTL;
+    header.protocol = protocol;
+    header.srcIP = srcIP;
+    header.dstIP = dstIP;
+    encodeHeader(header, buf.prepend(IPV4_HEADER_SIZE));
+}
+
+IPv4Packet IPv4Packet::decode(common::ByteView data) {
+    return IPv4Packet(IPv4View::parse(data));
+}
+
+common::DecodeStatus IPv4Packet::tryDecode(common::ByteView data, IPv4Packet& out) {
+    IPv4View view;
+    common::DecodeStatus status = IPv4View::tryParse(data, view);
+    if (status == common::DecodeStatus::Ok) {
+        out = IPv4Packet(view);
+    }
+    return status;
+}
+
+IPv4View IPv4View::parse(common::ByteView data) {
+    IPv4View view;
+    common::DecodeStatus status = tryParse(data, view);
+    if (status == common::DecodeStatus::BadIPVersion) {
+        throw std::runtime_error("Invalid IP version: " + std::to_string(fields::Version::get(data.data())));
     }
-    while (sum > 0xFFFF) {
-        sum = (sum >> 16) + (sum & 0xFFFF);
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
     }
-    return ~static_cast<uint16_t>(sum);
+    return view;
 }
 
-IPv4Packet IPv4Packet::decode(const std::vector<uint8_t>& data) {
+common::DecodeStatus IPv4View::tryParse(common::ByteView data, IPv4View& out) noexcept {
     if (data.size() < IPV4_HEADER_SIZE) {
-        throw std::runtime_error("Data too short for IPv4 header");
+        return common::DecodeStatus::IPv4TooShort;
     }
     
-    uint8_t version = (data[0] >> 4) & 0x0F;
-    if (version != 4) {
-        throw std::runtime_error("Invalid IP version: " + std::to_string(version));
+    if (fields::Version::get(data.data()) != 4) {
+        return common::DecodeStatus::BadIPVersion;
     }
     
-    uint8_t ihl = data[0] & 0x0F;
-    size_t headerLen = static_cast<size_t>(ihl) * 4;
+    size_t headerLen = static_cast<size_t>(fields::Ihl::get(data.data())) * 4;
     if (headerLen < IPV4_HEADER_SIZE || data.size() < headerLen) {
-        throw std::runtime_error("Invalid IP header length");
+        return common::DecodeStatus::BadIPHeaderLength;
     }
     
-    uint16_t totalLength = (static_cast<uint16_t>(data[2]) << 8) | data[3];
-    if (totalLength > data.size()) {
-        throw std::runtime_error("Invalid total length");
+    uint16_t totalLength = fields::TotalLength::get(data.data());
+    if (totalLength > data.size() || totalLength < headerLen) {
+        return common::DecodeStatus::BadIPTotalLength;
     }
     
-    uint16_t flagsFragOffset = (static_cast<uint16_t>(data[6]) << 8) | data[7];
-    
-    IPv4Packet packet;
-    packet.header_.version = version;
-    packet.header_.ihl = ihl;
-    packet.header_.tos = data[1];
-    packet.header_.totalLength = totalLength;
-    packet.header_.identification = (static_cast<uint16_t>(data[4]) << 8) | data[5];
-    packet.header_.flags = static_cast<uint8_t>(flagsFragOffset >> 13);
-    packet.header_.fragmentOffset = flagsFragOffset & 0x1FFF;
-    packet.header_.ttl = data[8];
-    packet.header_.protocol = data[9];
-    packet.header_.headerChecksum = (static_cast<uint16_t>(data[10]) << 8) | data[11];
-    std::copy(data.begin() + 12, data.begin() + 16, packet.header_.srcIP.begin());
-    std::copy(data.begin() + 16, data.begin() + 20, packet.header_.dstIP.begin());
-    
-    size_t payloadLen = totalLength - headerLen;
-    packet.payload_.assign(data.begin() + headerLen, data.begin() + headerLen + payloadLen);
-    
-    return packet;
+    // 以太网最小帧可能带有填充，按总长度截断
+    out = IPv4View(data.subview(0, totalLength));
+    return common::DecodeStatus::Ok;
+}
+
+bool IPv4View::checksumValid() const {
+    // 包含校验和字段在内的首部反码和应为全1
+    return common::checksum(data_.data(), headerLength()) == 0;
 }
 
 std::vector<uint8_t> IPv4Packet::getPayload() const {
-    return payload_;
+    return payload_.toVector();
 }
 
 IPv4Header IPv4Packet::getHeader() const {
@@ -0,0 +1,408 @@
+#include "network/ipv6.h"
+#include <sstream>
+#include <iomanip>
+
+namespace network {
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+// 写入不含前导零的十六进制组
+char* writeHexGroup(char* p, uint16_t value) {
+    bool started = false;
+    for (int shift = 12; shift >= 0; shift -= 4) {
+        unsigned nibble = (value >> shift) & 0xF;
+        if (nibble != 0 || started || shift == 0) {
+            *p++ = HEX_DIGITS[nibble];
+            started = true;
+        }
+    }
+    return p;
+}
+
+char* writeDecimal(char* p, uint8_t value) {
+    if (value >= 100) {
+        *p++ = static_cast<char>('0' + value / 100);
+    }
+    if (value >= 10) {
+        *p++ = static_cast<char>('0' + value / 10 % 10);
+    }
+    *p++ = static_cast<char>('0' + value % 10);
+    return p;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// 解析text[0, len)中的点分十进制IPv4地址
+bool parseDotted(const char* text, size_t len, uint8_t* out) {
+    size_t i = 0;
+    for (int part = 0; part < 4; ++part) {
+        if (part > 0) {
+            if (i == len || text[i] != '.') {
+                return false;
+            }
+            ++i;
+        }
+        unsigned value = 0;
+        size_t digits = 0;
+        while (i < len && text[i] >= '0' && text[i] <= '9' && digits < 3) {
+            value = value * 10 + static_cast<unsigned>(text[i] - '0');
+            ++i;
+            ++digits;
+        }
+        if (digits == 0 || value > 255) {
+            return false;
+        }
+        out[part] = static_cast<uint8_t>(value);
+    }
+    return i == len;
+}
+
+} // namespace
+
+IPv6Packet::IPv6Packet(const IPv6Address& srcIP, const IPv6Address& dstIP,
+                       uint8_t nextHeader, const std::vector<uint8_t>& payload)
+    : payload_(payload) {
+    header_.version = 6;
+    header_.trafficClass = 0;
+    header_.flowLabel = 0;
+    header_.payloadLength = static_cast<uint16_t>(payload.size());
+    header_.nextHeader = nextHeader;
+    header_.hopLimit = DEFAULT_HOP_LIMIT;
+    header_.srcIP = srcIP;
+    header_.dstIP = dstIP;
+}
+
+IPv6Packet::IPv6Packet(const IPv6View& view)
+    : header_(view.header()), payload_(view.payload()) {
+}
+
+IPv6Packet::IPv6Packet(const IPv6View& view, common::ByteStorage payload)
+    : header_(view.header()), payload_(std::move(payload)) {
+}
+
+IPv6Packet IPv6Packet::createUDP(const IPv6Address& srcIP, const IPv6Address& dstIP,
+                                 const std::vector<uint8_t>& payload) {
+    return IPv6Packet(srcIP, dstIP, PROTOCOL_UDP, payload);
+}
+
+std::vector<uint8_t> IPv6Packet::encode() const {
+    std::vector<uint8_t> buf(IPV6_HEADER_SIZE + payload_.size());
+
+    encodeHeader(header_, buf.data());
+
+    common::ByteView payload = payload_.view();
+    std::copy(payload.begin(), payload.end(), buf.begin() + IPV6_HEADER_SIZE);
+
+    return buf;
+}
+
+void IPv6Packet::prependHeader(common::PacketBuffer& buf, const IPv6Address& srcIP,
+                               const IPv6Address& dstIP, uint8_t nextHeader) {
+    if (buf.size() > 0xFFFF) {
+        throw std::runtime_error("Payload too large for IPv6 packet");
+    }
+
+    IPv6Header header{};
+    header.version = 6;
+    header.payloadLength = static_cast<uint16_t>(buf.size());
+    header.nextHeader = nextHeader;
+    header.hopLimit = DEFAULT_HOP_LIMIT;
+    header.srcIP = srcIP;
+    header.dstIP = dstIP;
+    encodeHeader(header, buf.prepend(IPV6_HEADER_SIZE));
+}
+
+IPv6Packet IPv6Packet::decode(common::ByteView data) {
+    return IPv6Packet(IPv6View::parse(data));
+}
+
+common::DecodeStatus IPv6Packet::tryDecode(common::ByteView data, IPv6Packet& out) {
+    IPv6View view;
+    common::DecodeStatus status = IPv6View::tryParse(data, view);
+    if (status == common::DecodeStatus::Ok) {
+        out = IPv6Packet(view);
+    }
+    return status;
+}
+
+IPv6View IPv6View::parse(common::ByteView data) {
+    IPv6View view;
+    common::DecodeStatus status = tryParse(data, view);
+    if (status == common::DecodeStatus::BadIPVersion) {
+        throw std::runtime_error("Invalid IP version: " + std::to_string(fields::Version::get(data.data())));
+    }
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
+    }
+    return view;
+}
+
+common::DecodeStatus IPv6View::tryParse(common::ByteView data, IPv6View& out) noexcept {
+    if (data.size() < IPV6_HEADER_SIZE) {
+        return common::DecodeStatus::IPv6TooShort;
+    }
+    if (fields::Version::get(data.data()) != 6) {
+        return common::DecodeStatus::BadIPVersion;
+    }
+
+    size_t totalLength = IPV6_HEADER_SIZE + fields::PayloadLength::get(data.data());
+    if (totalLength > data.size()) {
+        return common::DecodeStatus::BadIPv6PayloadLength;
+    }
+
+    // 以太网最小帧可能带有填充，按载荷长度截断
+    out = IPv6View(data.subview(0, totalLength));
+    return common::DecodeStatus::Ok;
+}
+
+common::DecodeStatus IPv6View::walkExtensions(IPv6Extensions& out) const noexcept {
+    out = IPv6Extensions();
+    const uint8_t* p = data_.data();
+    size_t size = data_.size();
+    uint8_t next = nextHeader();
+    size_t offset = IPV6_HEADER_SIZE;
+
+    for (;;) {
+        size_t length;
+        switch (next) {
+            case IPV6_EXT_HOP_BY_HOP:
+                // 逐跳选项只能紧跟固定首部
+                if (out.count != 0) {
+                    return common::DecodeStatus::BadIPv6Extension;
+                }
+                [[fallthrough]];
+            case IPV6_EXT_ROUTING:
+            case IPV6_EXT_DEST_OPTIONS:
+                // 长度字段以8字节为单位，不含第一个8字节
+                if (size < offset + 2) {
+                    return common::DecodeStatus::BadIPv6Extension;
+                }
+                length = (static_cast<size_t>(p[offset + 1]) + 1) * 8;
+                break;
+            case IPV6_EXT_AH:
+                // 认证首部的长度以4字节为单位，不含前两个4字节
+                if (size < offset + 2) {
+                    return common::DecodeStatus::BadIPv6Extension;
+                }
+                length = (static_cast<size_t>(p[offset + 1]) + 2) * 4;
+                break;
+            case IPV6_EXT_FRAGMENT: {
+                length = IPV6_FRAGMENT_HEADER_SIZE;
+                if (size < offset + length) {
+                    return common::DecodeStatus::BadIPv6Extension;
+                }
+                uint16_t offsetFlags = common::loadBE16(p + offset + 2);
+                out.fragment = true;
+                out.fragmentOffset = static_cast<uint16_t>(offsetFlags >> 3);
+                out.moreFragments = (offsetFlags & 1) != 0;
+                out.identification = common::loadBE32(p + offset + 4);
+                break;
+            }
+            default:
+                out.protocol = next;
+                out.offset = static_cast<uint32_t>(offset);
+                return common::DecodeStatus::Ok;
+        }
+        if (out.count == IPV6_MAX_EXTENSION_HEADERS || size < offset + length) {
+            return common::DecodeStatus::BadIPv6Extension;
+        }
+        next = p[offset];
+        offset += length;
+        ++out.count;
+    }
+}
+
+std::vector<uint8_t> IPv6Packet::getPayload() const {
+    return payload_.toVector();
+}
+
+IPv6Header IPv6Packet::getHeader() const {
+    return header_;
+}
+
+bool IPv6Packet::isUDP() const {
+    return header_.nextHeader == PROTOCOL_UDP;
+}
+
+std::string IPv6Packet::addressToString(const IPv6Address& ip) {
+    uint16_t groups[8];
+    for (size_t i = 0; i < 8; ++i) {
+        groups[i] = common::loadBE16(ip.data() + 2 * i);
+    }
+
+    // ::ffff:a.b.c.d
+    bool mapped = groups[0] == 0 && groups[1] == 0 && groups[2] == 0 && groups[3] == 0 &&
+                  groups[4] == 0 && groups[5] == 0xFFFF;
+    size_t hexGroups = mapped ? 6 : 8;
+
+    // 最长的连续零组（至少两组，长度相同时取靠前的）
+    size_t bestStart = hexGroups;
+    size_t bestLength = 1;
+    for (size_t i = 0; i < hexGroups;) {
+        if (groups[i] != 0) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        while (i < hexGroups && groups[i] == 0) {
+            ++i;
+        }
+        if (i - start > bestLength) {
+            bestStart = start;
+            bestLength = i - start;
+        }
+    }
+
+    char buf[48];
+    char* p = buf;
+    for (size_t i = 0; i < hexGroups;) {
+        if (i == bestStart) {
+            *p++ = ':';
+            *p++ = ':';
+            i += bestLength;
+            continue;
+        }
+        if (p != buf && p[-1] != ':') {
+            *p++ = ':';
+        }
+        p = writeHexGroup(p, groups[i]);
+        ++i;
+    }
+    if (mapped) {
+        if (p[-1] != ':') {
+            *p++ = ':';
+        }
+        for (size_t i = 12; i < 16; ++i) {
+            if (i > 12) {
+                *p++ = '.';
+            }
+            p = writeDecimal(p, ip[i]);
+        }
+    }
+    return std::string(buf, p);
+}
+
+bool IPv6Packet::tryParseAddress(const char* text, size_t len, IPv6Address& out) noexcept {
+    uint16_t groups[8];
+    size_t count = 0;
+    size_t gap = 8;  // "::"所在的组位置，8表示没有
+    size_t i = 0;
+
+    if (len >= 2 && text[0] == ':' && text[1] == ':') {
+        gap = 0;
+        i = 2;
+    } else if (len > 0 && text[0] == ':') {
+        return false;
+    }
+
+    while (i < len) {
+        if (count == 8) {
+            return false;
+        }
+
+        // 本组之后先出现'.'说明是结尾的IPv4地址
+        size_t end = i;
+        while (end < len && text[end] != ':' && text[end] != '.') {
+            ++end;
+        }
+        if (end < len && text[end] == '.') {
+            uint8_t v4[4];
+            if (count > 6 || !parseDotted(text + i, len - i, v4)) {
+                return false;
+            }
+            groups[count++] = static_cast<uint16_t>((v4[0] << 8) | v4[1]);
+            groups[count++] = static_cast<uint16_t>((v4[2] << 8) | v4[3]);
+            i = len;
+            break;
+        }
+
+        if (end == i || end - i > 4) {
+            return false;
+        }
+        unsigned value = 0;
+        for (; i < end; ++i) {
+            int digit = hexValue(text[i]);
+            if (digit < 0) {
+                return false;
+            }
+            value = (value << 4) | static_cast<unsigned>(digit);
+        }
+        groups[count++] = static_cast<uint16_t>(value);
+
+        if (i == len) {
+            break;
+        }
+        ++i;  // ':'
+        if (i < len && text[i] == ':') {
+            if (gap != 8) {
+                return false;
+            }
+            gap = count;
+            ++i;
+        } else if (i == len) {
+            return false;
+        }
+    }
+
+    if (gap == 8) {
+        if (count != 8) {
+            return false;
+        }
+    } else {
+        // "::"至少代表一个零组
+        if (count > 7) {
+            return false;
+        }
+        size_t tail = count - gap;
+        for (size_t k = 0; k < tail; ++k) {
+            groups[7 - k] = groups[count - 1 - k];
+        }
+        for (size_t k = gap; k < 8 - tail; ++k) {
+            groups[k] = 0;
+        }
+    }
+
+    for (size_t k = 0; k < 8; ++k) {
+        common::storeBE16(out.data() + 2 * k, groups[k]);
+    }
+    return true;
+}
+
+IPv6Address IPv6Packet::parseAddress(const std::string& text) {
+    IPv6Address ip{};
+    if (!tryParseAddress(text.data(), text.size(), ip)) {
+        throw std::runtime_error("Invalid IPv6 address format: " + text);
+    }
+    return ip;
+}
+
+std::string IPv6Packet::toString() const {
+    std::ostringstream oss;
+    oss << "IPv6 Packet:\n"
+        << "  Version: " << static_cast<int>(header_.version) << "\n"
+        << "  Traffic Class: " << static_cast<int>(header_.trafficClass) << "\n"
+        << "  Flow Label: 0x" << std::hex << std::setfill('0') << std::setw(5) << header_.flowLabel << "\n"
+        << std::dec
+        << "  Payload Length: " << header_.payloadLength << "\n"
+        << "  Next Header: " << static_cast<int>(header_.nextHeader) << "\n"
+        << "  Hop Limit: " << static_cast<int>(header_.hopLimit) << "\n"
+        << "  Source IP: " << addressToString(header_.srcIP) << "\n"
+        << "  Dest IP: " << addressToString(header_.dstIP) << "\n"
+        << "  Payload Size: " << payload_.size() << " bytes";
+    return oss.str();
+}
+
+} // namespace network
@@ -0,0 +1,82 @@
+#include "receiver/parsed_packet.h"
+#include <stdexcept>
+
+namespace receiver {
+
+ParsedPacket::ParsedPacket(common::ByteStorage storage, bool verifyChecksums)
+    : storage_(std::move(storage)), verifyChecksums_(verifyChecksums) {
+    ethernet_ = datalink::EthernetView::parse(storage_.view());
+    if (ethernet_.etherType() == datalink::ETHERTYPE_IPV6) {
+        ipVersion_ = 6;
+        ipv6_ = network::IPv6View::parse(ethernet_.payload());
+        network::IPv6Extensions extensions;
+        if (ipv6_.walkExtensions(extensions) != common::DecodeStatus::Ok) {
+            common::throwDecodeError(common::DecodeStatus::BadIPv6Extension);
+        }
+        protocol_ = extensions.protocol;
+        transport_ = ipv6_.upperLayer(extensions);
+    } else {
+        ipv4_ = network::IPv4View::parse(ethernet_.payload());
+        protocol_ = ipv4_.protocol();
+        transport_ = ipv4_.payload();
+    }
+}
+
+const transport::UDPView& ParsedPacket::udp() {
+    if (!udp_) {
+        if (protocol_ != network::PROTOCOL_UDP) {
+            common::throwDecodeError(common::DecodeStatus::NotUDP);
+        }
+        auto udp = transport::UDPView::parse(transport_);
+        if (verifyChecksums_ && !(isIPv6() ? udp.checksumValid(ipv6_.srcIP(), ipv6_.dstIP())
+                                           : udp.checksumValid(ipv4_.srcIP(), ipv4_.dstIP()))) {
+            common::throwDecodeError(common::DecodeStatus::BadUDPChecksum);
+        }
+        udp_ = udp;
+    }
+    return *udp_;
+}
+
+datalink::EthernetFrame& ParsedPacket::ethernetFrame() {
+    if (!ethernetFrame_) {
+        ethernetFrame_.emplace(ethernet_, slice(ethernet_.payload()));
+    }
+    return *ethernetFrame_;
+}
+
+network::IPv4Packet& ParsedPacket::ipv4Packet() {
+    if (isIPv6()) {
+        throw std::runtime_error("Packet is not IPv4");
+    }
+    if (!ipv4Packet_) {
+        ipv4Packet_.emplace(ipv4_, slice(ipv4_.payload()));
+    }
+    return *ipv4Packet_;
+}
+
+network::IPv6Packet& ParsedPacket::ipv6Packet() {
+    if (!isIPv6()) {
+        throw std::runtime_error("Packet is not IPv6");
+    }
+    if (!ipv6Packet_) {
+        ipv6Packet_.emplace(ipv6_, slice(ipv6_.payload()));
+    }
+    return *ipv6Packet_;
+}
+
+transport::UDPDatagram& ParsedPacket::udpDatagram() {
+    if (!udpDatagram_) {
+        const transport::UDPView& view = udp();
+        udpDatagram_.emplace(view, slice(view.payload()));
+    }
+    return *udpDatagram_;
+}
+
+application::Data& ParsedPacket::applicationData() {
+    if (!applicationData_) {
+        applicationData_.emplace(slice(payload()));
+    }
+    return *applicationData_;
+}
+
+} // namespace receiver
@@ -0,0 +1,244 @@
+#include "receiver/pipeline.h"
+#include "datalink/ethernet.h"
+#include "network/ipv4.h"
+#include "network/ipv6.h"
+#include "network/fragment.h"
+#include "transport/udp.h"
+#include "common/cpu_relax.h"
+#include <chrono>
+#include <stdexcept>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace receiver {
+
+namespace {
+
+constexpr uint32_t SPIN_BEFORE_YIELD = 1024;
+
+uint64_t nowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+void pinToCore(std::thread& thread, size_t core) {
+#if defined(__linux__)
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores == 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % cores, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)core;
+#endif
+}
+
+} // namespace
+
+ReceivePipeline::ReceivePipeline(const PipelineConfig& config, Handler handler)
+    : config_(config), handler_(std::move(handler)) {
+    if (config_.workers == 0) {
+        throw std::runtime_error("Receive pipeline needs at least one worker");
+    }
+    workers_.reserve(config_.workers);
+    for (size_t i = 0; i < config_.workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>(config_.ringSize, config_.receiver));
+    }
+}
+
+ReceivePipeline::~ReceivePipeline() {
+    stop();
+}
+
+void ReceivePipeline::start() {
+    if (running_) {
+        return;
+    }
+    stopping_.store(false, std::memory_order_relaxed);
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&ReceivePipeline::run, this, i);
+        if (config_.pinCores) {
+            pinToCore(workers_[i]->thread, config_.firstCore + i);
+        }
+    }
+    running_ = true;
+}
+
+void ReceivePipeline::stop() {
+    if (!running_) {
+        return;
+    }
+    stopping_.store(true, std::memory_order_release);
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+    running_ = false;
+}
+
+size_t ReceivePipeline::workerFor(common::ByteView frame) const {
+    // 只读取散列所需的字段，不做完整解析
+    constexpr size_t ipOffset = datalink::ETHERNET_HEADER_SIZE;
+    if (workers_.size() == 1 || frame.size() < ipOffset + network::IPV4_HEADER_SIZE) {
+        return 0;
+    }
+    uint16_t etherType = datalink::fields::EtherType::get(frame.data());
+    if (etherType == datalink::ETHERTYPE_IPV6) {
+        return workerForIPv6(frame);
+    }
+    if (etherType != datalink::ETHERTYPE_IPV4) {
+        return 0;
+    }
+    
+    const uint8_t* ip = frame.data() + ipOffset;
+    size_t headerLen = static_cast<size_t>(network::fields::Ihl::get(ip)) * 4;
+    uint8_t protocol = network::fields::Protocol::get(ip);
+    bool fragment = (common::loadBE16(ip + 6) & 0x3FFF) != 0;
+    
+    uint32_t h;
+    if (!fragment && (protocol == network::PROTOCOL_UDP || protocol == network::PROTOCOL_TCP) &&
+        frame.size() >= ipOffset + headerLen + 4) {
+        const uint8_t* l4 = ip + headerLen;
+        h = hash_.hashIPv4(ip + network::fields::SrcIP::byteOffset, ip + network::fields::DstIP::byteOffset,
+                           transport::fields::SrcPort::get(l4), transport::fields::DstPort::get(l4));
+    } else {
+        h = hash_.hashIPv4(ip + network::fields::SrcIP::byteOffset, ip + network::fields::DstIP::byteOffset);
+    }
+    return h % workers_.size();
+}
+
+size_t ReceivePipeline::workerForIPv6(common::ByteView frame) const {
+    // 只在下一首部直接是UDP/TCP时取端口，带扩展首部的报文按地址对散列，
+    // 同一条流的报文扩展首部一致，仍落在同一线程上
+    constexpr size_t ipOffset = datalink::ETHERNET_HEADER_SIZE;
+    if (frame.size() < ipOffset + network::IPV6_HEADER_SIZE) {
+        return 0;
+    }
+    const uint8_t* ip = frame.data() + ipOffset;
+    const uint8_t* src = ip + network::fields::SrcIPv6::byteOffset;
+    const uint8_t* dst = ip + network::fields::DstIPv6::byteOffset;
+    uint8_t nextHeader = network::fields::NextHeader::get(ip);
+    
+    uint32_t h;
+    if ((nextHeader == network::PROTOCOL_UDP || nextHeader == network::PROTOCOL_TCP) &&
+        frame.size() >= ipOffset + network::IPV6_HEADER_SIZE + 4) {
+        const uint8_t* l4 = ip + network::IPV6_HEADER_SIZE;
+        h = hash_.hashIPv6(src, dst, transport::fields::SrcPort::get(l4), transport::fields::DstPort::get(l4));
+    } else {
+        h = hash_.hashIPv6(src, dst);
+    }
+    return h % workers_.size();
+}
+
+void ReceivePipeline::dispatch(common::ByteView frame) {
+    Worker& worker = *workers_[workerFor(frame)];
+    uint32_t spins = 0;
+    while (!worker.ring.tryPush(frame)) {
+        ++stalls_;
+        if (++spins < SPIN_BEFORE_YIELD) {
+            common::cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    ++worker.dispatched;
+}
+
+void ReceivePipeline::wait() {
+    for (auto& worker : workers_) {
+        uint32_t spins = 0;
+        while (worker->processed.load(std::memory_order_acquire) < worker->dispatched) {
+            if (++spins < SPIN_BEFORE_YIELD) {
+                common::cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+void ReceivePipeline::run(size_t index) {
+    Worker& worker = *workers_[index];
+    WorkerStats& stats = worker.stats;
+    uint64_t firstNs = 0;
+    uint64_t lastNs = 0;
+    uint32_t idle = 0;
+    
+    common::ByteView frame;
+    for (;;) {
+        if (!worker.ring.tryPop(frame)) {
+            // 队列刚变空时记录时间，避免逐帧读时钟
+            if (idle == 0 && firstNs != 0) {
+                lastNs = nowNs();
+            }
+            // 停止标志置位后再确认一次队列为空，保证之前入队的帧都被处理
+            if (stopping_.load(std::memory_order_acquire)) {
+                if (!worker.ring.tryPop(frame)) {
+                    break;
+                }
+            } else {
+                if (++idle < SPIN_BEFORE_YIELD) {
+                    common::cpuRelax();
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+        }
+        idle = 0;
+        
+        if (firstNs == 0) {
+            firstNs = nowNs();
+        }
+        process(index, frame);
+        worker.processed.store(worker.processed.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_release);
+    }
+    
+    stats.activeNs = lastNs > firstNs ? lastNs - firstNs : 0;
+}
+
+void ReceivePipeline::process(size_t index, common::ByteView frame) {
+    Worker& worker = *workers_[index];
+    WorkerStats& stats = worker.stats;
+    stats.bytes += frame.size();
+    if (!worker.receiver.packetFilter().matches(frame)) {
+        ++stats.filtered;
+        return;
+    }
+    if (!worker.receiver.classify(frame)) {
+        ++stats.skipped;
+        return;
+    }
+    
+    PacketView view;
+    if (worker.receiver.tryDecapsulateView(frame, view) != common::DecodeStatus::Ok) {
+        ++stats.errors;
+        return;
+    }
+    if (view.pending) {
+        ++stats.fragments;
+        return;
+    }
+    ++stats.packets;
+    if (handler_) {
+        handler_(index, view);
+    }
+}
+
+std::vector<WorkerStats> ReceivePipeline::stats() const {
+    std::vector<WorkerStats> result;
+    result.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        result.push_back(worker->stats);
+        result.back().drops = worker->receiver.drops();
+    }
+    return result;
+}
+
+} // namespace receiver
@@ -1,81 +1,188 @@
 #include "receiver/receiver.h"
+#include "io/pcap.h"
+#include "common/checksum.h"
 #include <fstream>
-#include <iostream>
-#include <iomanip>
+#include <chrono>
 
 namespace receiver {
 
-ParsedPacket Receiver::decapsulate(const std::vector<uint8_t>& data) {
-    ParsedPacket result;
-    
-    std::cout << "=== Starting Decapsulation ===" << std::endl;
-    std::cout << "Total bytes received: " << data.size() << std::endl << std::endl;
-    
-    // 1. 解析以太网帧
-    std::cout << "--- Data Link Layer (Ethernet II) ---" << std::endl;
-    auto ethFrame = datalink::EthernetFrame::decode(data);
-    
-    std::cout << "  Dest MAC: " << datalink::EthernetFrame::macToString(ethFrame.getHeader().dstMAC) << std::endl;
-    std::cout << "  Source MAC: " << datalink::EthernetFrame::macToString(ethFrame.getHeader().srcMAC) << std::endl;
-    std::cout << "  EtherType: 0x" << std::hex << std::setfill('0') << std::setw(4) 
-              << ethFrame.getHeader().etherType << std::dec << std::endl;
-    
-    if (!ethFrame.isIPv4()) {
-        throw std::runtime_error("EtherType is not IPv4 (0x0800)");
+common::DecodeStatus Receiver::parseNetwork(common::ByteView data, PacketView& view,
+                                            uint8_t& protocol, common::ByteView& transport) {
+    common::DecodeStatus status = datalink::EthernetView::tryParse(data, view.ethernet);
+    if (status != common::DecodeStatus::Ok) {
+        return status;
     }
-    std::cout << "  EtherType verified: IPv4" << std::endl;
-    
-    result.ethernetFrame = std::make_unique<datalink::EthernetFrame>(ethFrame);
-    
-    // 2. 解析IPv4数据报
-    std::cout << "\n--- Network Layer (IPv4) ---" << std::endl;
-    auto ipPacket = network::IPv4Packet::decode(ethFrame.getPayload());
-    
-    auto ipHeader = ipPacket.getHeader();
-    std::cout << "  Version: " << static_cast<int>(ipHeader.version) << std::endl;
-    std::cout << "  Header Length: " << (ipHeader.ihl * 4) << " bytes" << std::endl;
-    std::cout << "  Total Length: " << ipHeader.totalLength << " bytes" << std::endl;
-    std::cout << "  TTL: " << static_cast<int>(ipHeader.ttl) << std::endl;
-    std::cout << "  Protocol: " << static_cast<int>(ipHeader.protocol) << std::endl;
-    std::cout << "  Source IP: " << network::IPv4Packet::ipToString(ipHeader.srcIP) << std::endl;
-    std::cout << "  Dest IP: " << network::IPv4Packet::ipToString(ipHeader.dstIP) << std::endl;
-    
-    if (!ipPacket.isUDP()) {
-        throw std::runtime_error("Protocol is not UDP (17)");
+    if (view.ethernet.etherType() == datalink::ETHERTYPE_IPV6) {
+        view.ipVersion = 6;
+        status = network::IPv6View::tryParse(view.ethernet.payload(), view.ipv6);
+        if (status != common::DecodeStatus::Ok) {
+            return status;
+        }
+        network::IPv6Extensions extensions;
+        status = view.ipv6.walkExtensions(extensions);
+        if (status != common::DecodeStatus::Ok) {
+            return status;
+        }
+        if (extensions.fragment) {
+            return common::DecodeStatus::IPv6Fragment;
+        }
+        protocol = extensions.protocol;
+        transport = view.ipv6.upperLayer(extensions);
+        return common::DecodeStatus::Ok;
+    }
+    if (!view.ethernet.isIPv4()) {
+        return common::DecodeStatus::NotIP;
     }
-    std::cout << "  Protocol verified: UDP (17)" << std::endl;
-    
-    result.ipv4Packet = std::make_unique<network::IPv4Packet>(ipPacket);
-    
-    // 3. 解析UDP数据报
-    std::cout << "\n--- Transport Layer (UDP) ---" << std::endl;
-    auto udpDatagram = transport::UDPDatagram::decode(ipPacket.getPayload());
-    
-    auto udpHeader = udpDatagram.getHeader();
-    std::cout << "  Source Port: " << udpHeader.srcPort << std::endl;
-    std::cout << "  Dest Port: " << udpHeader.dstPort << std::endl;
-    std::cout << "  UDP Length: " << udpHeader.length << " bytes" << std::endl;
-    std::cout << "  Checksum: 0x" << std::hex << std::setfill('0') << std::setw(4) 
-              << udpHeader.checksum << std::dec << std::endl;
-    
-    result.udpDatagram = std::make_unique<transport::UDPDatagram>(udpDatagram);
-    
-    // 4. 还原应用层数据
-    std::cout << "\n--- Application Layer ---" << std::endl;
-    auto appData = application::Data(udpDatagram.getPayload());
     
-    std::cout << "  Data: " << appData.getPayloadString() << std::endl;
-    std::cout << "  Size: " << appData.size() << " bytes" << std::endl;
+    status = network::IPv4View::tryParse(view.ethernet.payload(), view.ipv4);
+    if (status != common::DecodeStatus::Ok) {
+        return status;
+    }
+    if (options_.verifyChecksums && !view.ipv4.checksumValid()) {
+        return common::DecodeStatus::BadIPChecksum;
+    }
+    if (network::isFragment(view.ipv4)) {
+        if (!options_.reassemble) {
+            return common::DecodeStatus::FragmentRejected;
+        }
+        if (!reassembler_) {
+            reassembler_ = std::make_unique<network::Reassembler>(options_.reassembly);
+        }
+        
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        uint64_t nowNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        common::ByteView datagram;
+        if (!reassembler_->add(view.ipv4, nowNs, datagram)) {
+            view.pending = true;
+            return common::DecodeStatus::Ok;
+        }
+        status = network::IPv4View::tryParse(datagram, view.ipv4);
+        if (status != common::DecodeStatus::Ok) {
+            return status;
+        }
+    }
+    protocol = view.ipv4.protocol();
+    transport = view.ipv4.payload();
+    return common::DecodeStatus::Ok;
+}
+
+common::DecodeStatus Receiver::parseHeaders(common::ByteView data, PacketView& view) {
+    uint8_t protocol = 0;
+    common::ByteView transport;
+    common::DecodeStatus status = parseNetwork(data, view, protocol, transport);
+    if (status != common::DecodeStatus::Ok || view.pending) {
+        return status;
+    }
+    if (protocol != network::PROTOCOL_UDP) {
+        return common::DecodeStatus::NotUDP;
+    }
     
-    result.applicationData = std::make_unique<application::Data>(appData);
+    status = transport::UDPView::tryParse(transport, view.udp);
+    if (status == common::DecodeStatus::Ok) {
+        view.payload = view.udp.payload();
+    }
+    return status;
+}
+
+common::DecodeStatus Receiver::tryDecapsulateView(common::ByteView data, PacketView& view) {
+    view = PacketView();
+    common::DecodeStatus status = parseHeaders(data, view);
+    if (status == common::DecodeStatus::Ok && !view.pending && options_.verifyChecksums &&
+        !udpChecksumValid(view)) {
+        status = common::DecodeStatus::BadUDPChecksum;
+    }
+    if (status != common::DecodeStatus::Ok) {
+        drops_.add(status);
+    }
+    return status;
+}
+
+PacketView Receiver::decapsulateView(common::ByteView data) {
+    PacketView view;
+    common::DecodeStatus status = tryDecapsulateView(data, view);
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
+    }
+    return view;
+}
+
+ParsedPacket Receiver::decapsulate(common::ByteView data) {
+    return decapsulate(data, nullptr);
+}
+
+ParsedPacket Receiver::decapsulate(const common::BufferRef& frame) {
+    return decapsulate(frame.view(), &frame);
+}
+
+ParsedPacket Receiver::decapsulate(common::ByteView data, const common::BufferRef* frame) {
+    common::DecodeStatus status = common::DecodeStatus::Filtered;
+    PacketView view;
+    uint8_t protocol = 0;
+    common::ByteView transport;
+    if (options_.filter.matches(data)) {
+        status = parseNetwork(data, view, protocol, transport);
+    }
+    if (status != common::DecodeStatus::Ok) {
+        drops_.add(status);
+        common::throwDecodeError(status);
+    }
+    if (view.pending) {
+        common::throwDecodeError(common::DecodeStatus::Incomplete);
+    }
     
-    std::cout << "\n=== Decapsulation Complete ===" << std::endl;
+    // 重组后的数据报位于重组缓冲区中，与以太网首部一起拷贝出来
+    common::ByteStorage storage;
+    if (!view.isIPv6() && view.ipv4.bytes().data() != view.ethernet.payload().data()) {
+        std::vector<uint8_t> bytes(datalink::ETHERNET_HEADER_SIZE + view.ipv4.bytes().size());
+        std::copy(data.begin(), data.begin() + datalink::ETHERNET_HEADER_SIZE, bytes.begin());
+        std::copy(view.ipv4.bytes().begin(), view.ipv4.bytes().end(),
+                  bytes.begin() + datalink::ETHERNET_HEADER_SIZE);
+        storage = common::ByteStorage(std::move(bytes));
+    } else if (frame) {
+        storage = common::ByteStorage(*frame, 0, frame->size());
+    } else {
+        storage = common::ByteStorage(data);
+    }
     
-    return result;
+    ParsedPacket packet(std::move(storage), options_.verifyChecksums);
+    if (tracer_.enabled()) {
+        if (packet.isIPv6()) {
+            tracer_.packet(trace::makeRecord(trace::Direction::Decapsulate, packet.ethernet(),
+                                             packet.ipv6(), packet.udp()));
+        } else {
+            tracer_.packet(trace::makeRecord(trace::Direction::Decapsulate, packet.ethernet(),
+                                             packet.ipv4(), packet.udp()));
+        }
+    }
+    return packet;
+}
+
+void Receiver::traceView(const PacketView& view) const {
+    if (view.isIPv6()) {
+        tracer_.packet(trace::makeRecord(trace::Direction::Decapsulate, view.ethernet, view.ipv6, view.udp));
+    } else {
+        tracer_.packet(trace::makeRecord(trace::Direction::Decapsulate, view.ethernet, view.ipv4, view.udp));
+    }
+}
+
+bool Receiver::udpChecksumValid(const PacketView& view) {
+    return view.isIPv6() ? view.udp.checksumValid(view.ipv6.srcIP(), view.ipv6.dstIP())
+                         : view.udp.checksumValid(view.ipv4.srcIP(), view.ipv4.dstIP());
 }
 
 ParsedPacket Receiver::decapsulateFromFile(const std::string& filename) {
-    std::cout << "Reading file: " << filename << std::endl << std::endl;
+    if (io::isPcapFile(filename)) {
+        io::PcapReader reader(filename);
+        io::PcapRecord record;
+        if (!reader.next(record)) {
+            throw std::runtime_error("No frames in capture file: " + filename);
+        }
+        if (tracer_.enabled()) {
+            tracer_.file(trace::FileRecord{trace::Direction::Decapsulate, filename, record.data.size()});
+        }
+        return decapsulate(record.data);
+    }
     
     std::ifstream file(filename, std::ios::binary);
     if (!file) {
@@ -86,12 +193,66 @@ ParsedPacket Receiver::decapsulateFromFile(const std::string& filename) {
                                std::istreambuf_iterator<char>());
     file.close();
     
+    if (tracer_.enabled()) {
+        tracer_.file(trace::FileRecord{trace::Direction::Decapsulate, filename, data.size()});
+    }
+    
     return decapsulate(data);
 }
 
+CaptureStats Receiver::decapsulateCapture(const std::string& filename,
+                                          const std::function<void(const PacketView&)>& handler) {
+    io::PcapReader reader(filename);
+    if (reader.linkType() != io::PCAP_LINKTYPE_ETHERNET) {
+        throw std::runtime_error("Unsupported pcap link type: " + std::to_string(reader.linkType()));
+    }
+    
+    return decapsulateStream(reader, handler);
+}
+
+CaptureStats Receiver::decapsulateStream(io::FrameReader& reader,
+                                         const std::function<void(const PacketView&)>& handler) {
+    CaptureStats stats;
+    common::ByteView frame;
+    while (reader.next(frame)) {
+        ++stats.frames;
+        stats.bytes += frame.size();
+        if (!options_.filter.matches(frame)) {
+            ++stats.filtered;
+            continue;
+        }
+        if (!classify(frame)) {
+            ++stats.skipped;
+            continue;
+        }
+        PacketView view;
+        if (tryDecapsulateView(frame, view) != common::DecodeStatus::Ok) {
+            ++stats.errors;
+            continue;
+        }
+        if (view.pending) {
+            ++stats.fragments;
+            continue;
+        }
+        ++stats.decoded;
+        if (tracer_.enabled()) {
+            traceView(view);
+        }
+        if (handler) {
+            handler(view);
+        }
+    }
+    
+    return stats;
+}
+
+network::ReassemblyStats Receiver::reassemblyStats() const {
+    return reassembler_ ? reassembler_->stats() : network::ReassemblyStats();
+}
+
 std::string Receiver::getApplicationData(const std::string& filename) {
     auto parsed = decapsulateFromFile(filename);
-    return parsed.applicationData->getPayloadString();
+    return parsed.applicationData().getPayloadString();
 }
 
 } // namespace receiver
@@ -0,0 +1,97 @@
+#include "sender/header_template.h"
+#include "sender/sender.h"
+#include "common/checksum.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace sender {
+
+HeaderTemplate::HeaderTemplate(const Config& config) : ipv6_(config.ipv6) {
+    size_t udpOffset = datalink::ETHERNET_HEADER_SIZE +
+                       writeNetwork(config, header_.data(), network::PROTOCOL_UDP, 0, ipSum_, udpSum_);
+    size_ = udpOffset + transport::UDP_HEADER_SIZE;
+
+    transport::UDPHeader udpHeader{};
+    udpHeader.srcPort = config.srcPort;
+    udpHeader.dstPort = config.dstPort;
+    transport::UDPDatagram::encodeHeader(udpHeader, header_.data() + udpOffset);
+    udpSum_ = common::checksumPartial(header_.data() + udpOffset, transport::UDP_HEADER_SIZE, udpSum_);
+}
+
+void HeaderTemplate::write(uint8_t* out, size_t payloadLen, uint32_t payloadSum, uint16_t ipId) const {
+    size_t udpLength = transport::UDP_HEADER_SIZE + payloadLen;
+    if (ipv6_ && udpLength > 0xFFFF) {
+        throw std::runtime_error("Payload too large for IPv6 packet");
+    }
+    if (!ipv6_ && network::IPV4_HEADER_SIZE + udpLength > 0xFFFF) {
+        throw std::runtime_error("Payload too large for IPv4 packet");
+    }
+
+    std::memcpy(out, header_.data(), size_);
+    patchNetwork(out + datalink::ETHERNET_HEADER_SIZE, ipv6_, ipSum_, static_cast<uint16_t>(udpLength), ipId);
+
+    // UDP长度同时出现在伪首部和首部中
+    uint8_t* udp = out + size_ - transport::UDP_HEADER_SIZE;
+    transport::fields::Length::set(udp, static_cast<uint16_t>(udpLength));
+    uint32_t sum = common::checksumAdd(udpSum_, static_cast<uint32_t>(udpLength) * 2);
+    sum = common::checksumAdd(sum, payloadSum);
+    uint16_t checksum = common::checksumFinish(sum);
+    // 计算结果为0时以全1发送，0留作"未计算"
+    transport::fields::Checksum::set(udp, checksum == 0 ? 0xFFFF : checksum);
+}
+
+size_t HeaderTemplate::writeFrame(uint8_t* out, common::ByteView payload, uint16_t ipId) const {
+    uint32_t payloadSum = common::checksumCopy(out + size_, payload.data(), payload.size());
+    write(out, payload.size(), payloadSum, ipId);
+    return size_ + payload.size();
+}
+
+size_t HeaderTemplate::writeNetwork(const Config& config, uint8_t* out, uint8_t protocol, uint8_t ipFlags,
+                                    uint32_t& ipSum, uint32_t& pseudoSum) {
+    datalink::EthernetHeader ethHeader;
+    ethHeader.dstMAC = config.dstMAC;
+    ethHeader.srcMAC = config.srcMAC;
+    ethHeader.etherType = config.ipv6 ? datalink::ETHERTYPE_IPV6 : datalink::ETHERTYPE_IPV4;
+    datalink::EthernetFrame::encodeHeader(ethHeader, out);
+
+    uint8_t* ip = out + datalink::ETHERNET_HEADER_SIZE;
+    if (config.ipv6) {
+        network::IPv6Header ipHeader{};
+        ipHeader.version = 6;
+        ipHeader.nextHeader = protocol;
+        ipHeader.hopLimit = network::DEFAULT_HOP_LIMIT;
+        ipHeader.srcIP = config.srcIPv6;
+        ipHeader.dstIP = config.dstIPv6;
+        network::IPv6Packet::encodeHeader(ipHeader, ip);
+        ipSum = 0;
+        pseudoSum = transport::pseudoHeaderSum(config.srcIPv6, config.dstIPv6, protocol, 0);
+        return network::IPV6_HEADER_SIZE;
+    }
+
+    network::IPv4Header ipHeader{};
+    ipHeader.version = 4;
+    ipHeader.ihl = 5;
+    ipHeader.flags = ipFlags;
+    ipHeader.ttl = network::DEFAULT_TTL;
+    ipHeader.protocol = protocol;
+    ipHeader.srcIP = config.srcIP;
+    ipHeader.dstIP = config.dstIP;
+    network::fields::IPv4Codec::encode(ipHeader, ip);
+    ipSum = common::checksumPartial(ip, network::IPV4_HEADER_SIZE);
+    pseudoSum = transport::pseudoHeaderSum(config.srcIP, config.dstIP, protocol, 0);
+    return network::IPV4_HEADER_SIZE;
+}
+
+void HeaderTemplate::patchNetwork(uint8_t* ip, bool ipv6, uint32_t ipSum, uint16_t payloadLength, uint16_t ipId) {
+    if (ipv6) {
+        network::fields::PayloadLength::set(ip, payloadLength);
+        return;
+    }
+    uint16_t totalLength = static_cast<uint16_t>(network::IPV4_HEADER_SIZE + payloadLength);
+    network::fields::TotalLength::set(ip, totalLength);
+    network::fields::Identification::set(ip, ipId);
+    network::fields::HeaderChecksum::set(
+        ip, common::checksumFinish(common::checksumAdd(common::checksumAdd(ipSum, totalLength), ipId)));
+}
+
+} // namespace sender
@@ -0,0 +1,179 @@
+#include "sender/pacer.h"
+#include "common/tsc_clock.h"
+#include "common/cpu_relax.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace sender {
+
+namespace {
+
+// 离下一次到期超过该时长时先睡眠，剩余部分忙等；
+// 需明显大于定时器松弛量（Linux默认50us），否则睡眠常会越过到期时刻
+constexpr uint64_t SPIN_NS = 200 * 1000;
+
+} // namespace
+
+Pacer::Pacer(uint64_t tickNs) : tickNs_(tickNs) {
+    if (tickNs_ == 0) {
+        throw std::runtime_error("Pacer tick must be positive");
+    }
+}
+
+size_t Pacer::addFlow(std::vector<uint8_t> frame, const FlowRate& rate) {
+    if (!(rate.rate > 0) || rate.burst == 0 || frame.empty()) {
+        throw std::runtime_error("Paced flow needs a frame, a positive rate and a positive burst");
+    }
+    
+    Flow flow{};
+    flow.cost = rate.unit == RateUnit::Bps ? static_cast<double>(frame.size()) * 8.0 : 1.0;
+    flow.tokensPerNs = rate.rate / 1e9;
+    flow.burst = rate.burst;
+    // 容量在burst之外留出追赶额度（至少一个刻度，抵消到期时刻向上取整带来的延迟）
+    flow.capacity = flow.cost * static_cast<double>(rate.burst) +
+                    flow.tokensPerNs * static_cast<double>(std::max(rate.catchUpNs, tickNs_));
+    flow.stats.requestedPps = rate.rate / flow.cost;
+    flow.stats.idealIntervalNs = 1e9 / flow.stats.requestedPps;
+    flow.frame = std::move(frame);
+    flows_.push_back(std::move(flow));
+    return flows_.size() - 1;
+}
+
+void Pacer::serve(Flow& flow, uint64_t nowNs, uint64_t& remaining, io::FrameWriter& out) {
+    const common::TscClock& clock = common::TscClock::instance();
+    flow.tokens = std::min(flow.capacity,
+                           flow.tokens + static_cast<double>(nowNs - flow.refillNs) * flow.tokensPerNs);
+    flow.refillNs = nowNs;
+    
+    size_t sent = 0;
+    while (flow.tokens >= flow.cost && sent < flow.burst && remaining > 0) {
+        out.write(flow.frame);
+        flow.tokens -= flow.cost;
+        ++sent;
+        --remaining;
+        
+        uint64_t sendNs = clock.nowNs();
+        if (flow.stats.packets > 0) {
+            double interval = static_cast<double>(sendNs - flow.lastSendNs);
+            ++flow.intervals;
+            double delta = interval - flow.mean;
+            flow.mean += delta / static_cast<double>(flow.intervals);
+            flow.m2 += delta * (interval - flow.mean);
+            flow.maxDeviation = std::max(flow.maxDeviation,
+                                         std::fabs(interval - flow.stats.idealIntervalNs));
+        }
+        flow.lastSendNs = sendNs;
+        ++flow.stats.packets;
+        flow.stats.bytes += flow.frame.size();
+    }
+}
+
+PacerStats Pacer::run(io::FrameWriter& out, uint64_t packets) {
+    if (flows_.empty()) {
+        throw std::runtime_error("Pacer has no flows");
+    }
+    
+    const common::TscClock& clock = common::TscClock::instance();
+    uint64_t startNs = clock.nowNs();
+    common::TimingWheel wheel(flows_.size(), 0);
+    for (size_t i = 0; i < flows_.size(); ++i) {
+        Flow& flow = flows_[i];
+        flow.tokens = flow.cost * static_cast<double>(flow.burst);
+        flow.refillNs = 0;
+        flow.intervals = 0;
+        flow.mean = 0;
+        flow.m2 = 0;
+        flow.maxDeviation = 0;
+        flow.stats.packets = 0;
+        flow.stats.bytes = 0;
+        wheel.schedule(static_cast<uint32_t>(i), 0);
+    }
+    
+    PacerStats stats;
+    uint64_t remaining = packets;
+    std::vector<uint32_t> due;
+    due.reserve(flows_.size());
+    while (remaining > 0) {
+        uint64_t nowNs = clock.nowNs() - startNs;
+        wheel.advance(nowNs / tickNs_, due);
+        if (due.empty()) {
+            uint64_t nextNs = wheel.nextTick() * tickNs_;
+            if (nextNs > nowNs + SPIN_NS) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(nextNs - nowNs - SPIN_NS));
+            } else {
+                common::cpuRelax();
+            }
+            continue;
+        }
+        
+        for (uint32_t id : due) {
+            Flow& flow = flows_[id];
+            serve(flow, nowNs, remaining, out);
+            // 令牌不足一个报文时按补足所需时间排期，受burst限制而停止时下一刻度继续
+            double deficit = flow.cost - flow.tokens;
+            uint64_t nextNs = nowNs;
+            if (deficit > 0) {
+                nextNs += static_cast<uint64_t>(std::ceil(deficit / flow.tokensPerNs));
+            }
+            wheel.schedule(id, (nextNs + tickNs_ - 1) / tickNs_);
+        }
+        due.clear();
+        out.flush();
+        ++stats.rounds;
+    }
+    stats.elapsedNs = clock.nowNs() - startNs;
+    
+    for (Flow& flow : flows_) {
+        PacedFlowStats result = flow.stats;
+        result.meanIntervalNs = flow.mean;
+        result.jitterNs = flow.intervals > 1 ?
+            std::sqrt(flow.m2 / static_cast<double>(flow.intervals - 1)) : 0.0;
+        result.maxDeviationNs = flow.maxDeviation;
+        result.achievedPps = stats.elapsedNs > 0 ?
+            static_cast<double>(result.packets) * 1e9 / static_cast<double>(stats.elapsedNs) : 0.0;
+        stats.packets += result.packets;
+        stats.bytes += result.bytes;
+        stats.requestedPps += result.requestedPps;
+        stats.flows.push_back(result);
+    }
+    return stats;
+}
+
+FlowRate parseRate(const std::string& spec) {
+    size_t pos = 0;
+    double value = 0;
+    try {
+        value = std::stod(spec, &pos);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid rate: " + spec);
+    }
+    
+    std::string unit = spec.substr(pos);
+    static const struct {
+        const char* name;
+        double scale;
+        RateUnit unit;
+    } UNITS[] = {
+        {"", 1, RateUnit::Pps},       {"pps", 1, RateUnit::Pps},
+        {"kpps", 1e3, RateUnit::Pps}, {"mpps", 1e6, RateUnit::Pps},
+        {"bps", 1, RateUnit::Bps},    {"kbps", 1e3, RateUnit::Bps},
+        {"mbps", 1e6, RateUnit::Bps}, {"gbps", 1e9, RateUnit::Bps},
+    };
+    for (const auto& entry : UNITS) {
+        if (unit == entry.name) {
+            if (!(value > 0)) {
+                break;
+            }
+            FlowRate rate;
+            rate.rate = value * entry.scale;
+            rate.unit = entry.unit;
+            return rate;
+        }
+    }
+    throw std::runtime_error("Invalid rate: " + spec);
+}
+
+} // namespace sender
@@ -1,63 +1,324 @@
 #include "sender/sender.h"
-#include "transport/udp.h"
+#include "common/packet_buffer.h"
+#include "common/checksum.h"
+#include <algorithm>
+#include <cstring>
+#include "io/pcap.h"
 #include <fstream>
-#include <iostream>
 
 namespace sender {
 
-Sender::Sender(const Config& config) : config_(config) {}
+namespace {
+
+// 以太网+IP（最长为IPv6）+传输层（最长为TCP）首部模板的容量
+constexpr size_t FRAME_TEMPLATE_CAPACITY = datalink::ETHERNET_HEADER_SIZE + network::IPV6_HEADER_SIZE +
+                                           transport::TCP_HEADER_SIZE;
+
+} // namespace
+
+Sender::Sender(const Config& config) : config_(config), headers_(config) {}
 
 std::vector<uint8_t> Sender::encapsulate(const application::Data& data) {
-    auto payload = data.getPayload();
-    std::cout << "Application Layer - Data: " << data.getPayloadString() 
-              << " (" << payload.size() << " bytes)" << std::endl;
-    
-    // 传输层 - 构建UDP数据报
-    transport::UDPDatagram udpDatagram(config_.srcPort, config_.dstPort, payload);
-    auto udpBytes = udpDatagram.encode();
-    std::cout << "\nTransport Layer (UDP):" << std::endl;
-    std::cout << "  Source Port: " << config_.srcPort << std::endl;
-    std::cout << "  Dest Port: " << config_.dstPort << std::endl;
-    std::cout << "  UDP Length: " << udpBytes.size() << " bytes (header: 8 + data: " 
-              << payload.size() << ")" << std::endl;
-    
-    // 网络层 - 构建IPv4数据报
-    auto ipPacket = network::IPv4Packet::createUDP(config_.srcIP, config_.dstIP, udpBytes);
-    auto ipBytes = ipPacket.encode();
-    std::cout << "\nNetwork Layer (IPv4):" << std::endl;
-    std::cout << "  Source IP: " << network::IPv4Packet::ipToString(config_.srcIP) << std::endl;
-    std::cout << "  Dest IP: " << network::IPv4Packet::ipToString(config_.dstIP) << std::endl;
-    std::cout << "  Protocol: UDP (17)" << std::endl;
-    std::cout << "  Total Length: " << ipBytes.size() << " bytes (header: 20 + UDP: " 
-              << udpBytes.size() << ")" << std::endl;
-    
-    // 数据链路层 - 构建以太网帧
-    auto ethFrame = datalink::EthernetFrame::createIPv4(config_.srcMAC, config_.dstMAC, ipBytes);
-    auto ethBytes = ethFrame.encode();
-    std::cout << "\nData Link Layer (Ethernet II):" << std::endl;
-    std::cout << "  Source MAC: " << datalink::EthernetFrame::macToString(config_.srcMAC) << std::endl;
-    std::cout << "  Dest MAC: " << datalink::EthernetFrame::macToString(config_.dstMAC) << std::endl;
-    std::cout << "  EtherType: 0x0800 (IPv4)" << std::endl;
-    std::cout << "  Frame Size: " << ethBytes.size() << " bytes (header: 14 + IP: " 
-              << ipBytes.size() << ")" << std::endl;
-    
-    return ethBytes;
+    // 载荷只拷贝一次（同时累加UDP校验和），首部由模板插入预留的头部空间
+    common::PacketBuffer buf(headerSize(), data.size());
+    common::ByteView payload = data.view();
+    uint32_t payloadSum = common::checksumCopy(buf.append(payload.size()), payload.data(),
+                                               payload.size());
+    headers_.write(buf.prepend(headerSize()), payload.size(), payloadSum);
+    
+    if (tracer_.enabled()) {
+        traceFrame(buf.view());
+    }
+    
+    return buf.release();
+}
+
+common::BufferRef Sender::encapsulate(const application::Data& data, common::BufferPool& pool) {
+    common::BufferRef buf = pool.allocate();
+    common::ByteView payload = data.view();
+    uint32_t payloadSum = common::checksumCopy(buf.append(payload.size()), payload.data(),
+                                               payload.size());
+    headers_.write(buf.prepend(headerSize()), payload.size(), payloadSum);
+    
+    if (tracer_.enabled()) {
+        traceFrame(buf.view());
+    }
+    return buf;
+}
+
+common::FrameBatch Sender::encapsulateBatch(const application::Data* data, size_t count) {
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        totalBytes += headerSize() + data[i].size();
+    }
+    
+    common::FrameBatch batch;
+    batch.reserve(count, totalBytes);
+    for (size_t i = 0; i < count; ++i) {
+        headers_.writeFrame(batch.appendFrame(headerSize() + data[i].size()), data[i].view());
+    }
+    
+    if (tracer_.enabled()) {
+        for (size_t i = 0; i < batch.count(); ++i) {
+            traceFrame(batch.frame(i));
+        }
+    }
+    
+    return batch;
+}
+
+common::FrameBatch Sender::encapsulateBatch(const std::vector<application::Data>& data) {
+    return encapsulateBatch(data.data(), data.size());
+}
+
+void Sender::appendFrame(common::FrameBatch& batch, common::ByteView payload) const {
+    headers_.writeFrame(batch.appendFrame(headerSize() + payload.size()), payload);
+}
+
+common::FrameBatch Sender::encapsulateFragments(const application::Data& data) {
+    common::ByteView payload = data.view();
+    if (config_.ipv6) {
+        // IPv6路由器不分片，源端分片需要分片扩展首部，这里只接受不超过MTU的数据报
+        if (network::IPV6_HEADER_SIZE + transport::UDP_HEADER_SIZE + payload.size() > config_.mtu) {
+            throw std::runtime_error("Payload exceeds MTU (IPv6 fragmentation is not supported)");
+        }
+        common::FrameBatch batch;
+        appendFrame(batch, payload);
+        if (tracer_.enabled()) {
+            traceFrame(batch.frame(0));
+        }
+        return batch;
+    }
+    size_t udpLength = transport::UDP_HEADER_SIZE + payload.size();
+    if (network::IPV4_HEADER_SIZE + udpLength > network::IPV4_MAX_PACKET_SIZE) {
+        throw std::runtime_error("Payload too large for IPv4 packet");
+    }
+    
+    // 非最后分片的数据长度必须是8的倍数
+    if (config_.mtu < network::IPV4_HEADER_SIZE + 8) {
+        throw std::runtime_error("MTU too small for IPv4 fragmentation");
+    }
+    size_t maxFragmentData = (config_.mtu - network::IPV4_HEADER_SIZE) & ~static_cast<size_t>(7);
+    size_t fragmentCount = (udpLength + maxFragmentData - 1) / maxFragmentData;
+    
+    constexpr size_t linkAndIp = datalink::ETHERNET_HEADER_SIZE + network::IPV4_HEADER_SIZE;
+    common::FrameBatch batch;
+    batch.reserve(fragmentCount, fragmentCount * linkAndIp + udpLength);
+    
+    datalink::EthernetHeader ethHeader;
+    ethHeader.dstMAC = config_.dstMAC;
+    ethHeader.srcMAC = config_.srcMAC;
+    ethHeader.etherType = datalink::ETHERTYPE_IPV4;
+    
+    network::IPv4Header ipHeader{};
+    ipHeader.version = 4;
+    ipHeader.ihl = 5;
+    ipHeader.ttl = network::DEFAULT_TTL;
+    ipHeader.protocol = network::PROTOCOL_UDP;
+    ipHeader.srcIP = config_.srcIP;
+    ipHeader.dstIP = config_.dstIP;
+    if (fragmentCount > 1) {
+        ipHeader.identification = network::IdGenerator::global().next(
+            config_.srcIP, config_.dstIP, network::PROTOCOL_UDP);
+    }
+    
+    // 逐个分片拷贝载荷并累加UDP校验和，UDP首部最后写入第一个分片
+    uint32_t payloadSum = 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < fragmentCount; ++i) {
+        size_t fragmentLen = std::min(maxFragmentData, udpLength - offset);
+        uint8_t* out = batch.appendFrame(linkAndIp + fragmentLen);
+        datalink::EthernetFrame::encodeHeader(ethHeader, out);
+        
+        ipHeader.totalLength = static_cast<uint16_t>(network::IPV4_HEADER_SIZE + fragmentLen);
+        ipHeader.flags = (offset + fragmentLen < udpLength) ? network::IPV4_FLAG_MF : 0;
+        ipHeader.fragmentOffset = static_cast<uint16_t>(offset / 8);
+        network::IPv4Packet::encodeHeader(ipHeader, out + datalink::ETHERNET_HEADER_SIZE);
+        
+        uint8_t* fragmentData = out + linkAndIp;
+        if (offset == 0) {
+            payloadSum = common::checksumCopy(fragmentData + transport::UDP_HEADER_SIZE, payload.data(),
+                                              fragmentLen - transport::UDP_HEADER_SIZE, payloadSum);
+        } else {
+            payloadSum = common::checksumCopy(fragmentData,
+                                              payload.data() + offset - transport::UDP_HEADER_SIZE,
+                                              fragmentLen, payloadSum);
+        }
+        offset += fragmentLen;
+    }
+    
+    transport::UDPHeader udpHeader;
+    udpHeader.srcPort = config_.srcPort;
+    udpHeader.dstPort = config_.dstPort;
+    udpHeader.length = static_cast<uint16_t>(udpLength);
+    udpHeader.checksum = transport::UDPDatagram::calculateChecksum(
+        config_.srcIP, config_.dstIP, udpHeader, payloadSum);
+    transport::UDPDatagram::encodeHeader(udpHeader, batch.frameData(0) + linkAndIp);
+    
+    if (tracer_.enabled() && fragmentCount == 1) {
+        traceFrame(batch.frame(0));
+    }
+    
+    return batch;
+}
+
+uint16_t Sender::nextIPId(uint8_t protocol) const {
+    return config_.ipv6 ? 0 : network::IdGenerator::global().next(config_.srcIP, config_.dstIP, protocol);
+}
+
+size_t Sender::mss() const {
+    size_t ipHeaderSize = config_.ipv6 ? network::IPV6_HEADER_SIZE : network::IPV4_HEADER_SIZE;
+    if (config_.mtu <= ipHeaderSize + transport::TCP_HEADER_SIZE) {
+        throw std::runtime_error("MTU too small for TCP segmentation");
+    }
+    return config_.mtu - ipHeaderSize - transport::TCP_HEADER_SIZE;
+}
+
+common::FrameBatch Sender::encapsulateSegments(const application::Data& data, uint32_t seq, uint32_t ack) {
+    common::ByteView payload = data.view();
+    size_t segmentSize = mss();
+    size_t segmentCount = payload.empty() ? 1 : (payload.size() + segmentSize - 1) / segmentSize;
+    
+    // 首部模板：长度、IP标识、序号与校验和字段为0，同时记下各校验和的不变部分
+    uint8_t header[FRAME_TEMPLATE_CAPACITY] = {};
+    uint32_t ipSum = 0;   // IPv4首部模板的部分和
+    uint32_t tcpSum = 0;  // 伪首部（长度为0）与TCP首部模板的部分和
+    size_t tcpOffset = datalink::ETHERNET_HEADER_SIZE +
+                       HeaderTemplate::writeNetwork(config_, header, network::PROTOCOL_TCP,
+                                                    network::IPV4_FLAG_DF, ipSum, tcpSum);
+    size_t frameHeaderSize = tcpOffset + transport::TCP_HEADER_SIZE;
+    // 与网卡TSO一致，各段的IP标识从同一起点依次递增
+    uint16_t ipId = nextIPId(network::PROTOCOL_TCP);
+    
+    transport::TCPHeader tcpHeader{};
+    tcpHeader.srcPort = config_.srcPort;
+    tcpHeader.dstPort = config_.dstPort;
+    tcpHeader.ack = ack;
+    tcpHeader.dataOffset = transport::TCP_HEADER_SIZE / 4;
+    tcpHeader.flags = transport::TCP_FLAG_ACK;
+    tcpHeader.window = transport::TCP_DEFAULT_WINDOW;
+    transport::TCPSegment::encodeHeader(tcpHeader, header + tcpOffset);
+    tcpSum = common::checksumPartial(header + tcpOffset, transport::TCP_HEADER_SIZE, tcpSum);
+    
+    common::FrameBatch batch;
+    batch.reserve(segmentCount, segmentCount * frameHeaderSize + payload.size());
+    
+    size_t offset = 0;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        size_t segmentLen = std::min(segmentSize, payload.size() - offset);
+        uint8_t* out = batch.appendFrame(frameHeaderSize + segmentLen);
+        std::memcpy(out, header, frameHeaderSize);
+        uint32_t payloadSum = common::checksumCopy(out + frameHeaderSize, payload.data() + offset, segmentLen);
+        
+        uint16_t tcpLength = static_cast<uint16_t>(transport::TCP_HEADER_SIZE + segmentLen);
+        HeaderTemplate::patchNetwork(out + datalink::ETHERNET_HEADER_SIZE, config_.ipv6, ipSum, tcpLength,
+                                     static_cast<uint16_t>(ipId + i));
+        
+        uint8_t* tcp = out + tcpOffset;
+        uint32_t segmentSeq = seq + static_cast<uint32_t>(offset);
+        transport::fields::SeqNumber::set(tcp, segmentSeq);
+        uint32_t sum = common::checksumAdd(tcpSum, segmentSeq >> 16);
+        sum = common::checksumAdd(sum, segmentSeq & 0xFFFF);
+        sum = common::checksumAdd(sum, tcpLength);
+        sum = common::checksumAdd(sum, payloadSum);
+        if (i + 1 == segmentCount) {
+            // PSH与ACK位于同一个16位字且互不重叠，直接累加
+            transport::fields::TCPFlags::set(tcp, transport::TCP_FLAG_ACK | transport::TCP_FLAG_PSH);
+            sum = common::checksumAdd(sum, transport::TCP_FLAG_PSH);
+        }
+        transport::fields::TCPChecksum::set(tcp, common::checksumFinish(sum));
+        offset += segmentLen;
+    }
+    
+    return batch;
+}
+
+size_t Sender::maxDatagramPayload() const {
+    size_t ipHeaderSize = config_.ipv6 ? network::IPV6_HEADER_SIZE : network::IPV4_HEADER_SIZE;
+    if (config_.mtu <= ipHeaderSize + transport::UDP_HEADER_SIZE) {
+        throw std::runtime_error("MTU too small for UDP segmentation");
+    }
+    return config_.mtu - ipHeaderSize - transport::UDP_HEADER_SIZE;
+}
+
+common::FrameBatch Sender::encapsulateDatagrams(const application::Data& data) {
+    common::ByteView payload = data.view();
+    size_t segmentSize = maxDatagramPayload();
+    size_t datagramCount = payload.empty() ? 1 : (payload.size() + segmentSize - 1) / segmentSize;
+    uint16_t ipId = nextIPId(network::PROTOCOL_UDP);
+    
+    common::FrameBatch batch;
+    batch.reserve(datagramCount, datagramCount * headerSize() + payload.size());
+    
+    size_t offset = 0;
+    for (size_t i = 0; i < datagramCount; ++i) {
+        common::ByteView part = payload.subview(offset, std::min(segmentSize, payload.size() - offset));
+        headers_.writeFrame(batch.appendFrame(headerSize() + part.size()), part,
+                            static_cast<uint16_t>(ipId + i));
+        offset += part.size();
+    }
+    
+    if (tracer_.enabled()) {
+        for (size_t i = 0; i < batch.count(); ++i) {
+            traceFrame(batch.frame(i));
+        }
+    }
+    
+    return batch;
+}
+
+void Sender::traceFrame(common::ByteView frame) const {
+    auto ethernet = datalink::EthernetView::parse(frame);
+    if (config_.ipv6) {
+        auto ipv6 = network::IPv6View::parse(ethernet.payload());
+        auto udp = transport::UDPView::parse(ipv6.payload());
+        tracer_.packet(trace::makeRecord(trace::Direction::Encapsulate, ethernet, ipv6, udp));
+        return;
+    }
+    auto ipv4 = network::IPv4View::parse(ethernet.payload());
+    auto udp = transport::UDPView::parse(ipv4.payload());
+    tracer_.packet(trace::makeRecord(trace::Direction::Encapsulate, ethernet, ipv4, udp));
+}
+
+void Sender::send(const application::Data& data, io::FrameWriter& out) {
+    size_t frameSize = headerSize() + data.size();
+    uint8_t* slot = out.reserve(frameSize);
+    if (!slot) {
+        out.write(encapsulate(data));
+        return;
+    }
+    
+    headers_.writeFrame(slot, data.view());
+    if (tracer_.enabled()) {
+        traceFrame(common::ByteView(slot, frameSize));
+    }
+    out.commit(frameSize);
+}
+
+void Sender::send(const application::Data* data, size_t count, io::FrameWriter& out) {
+    out.write(encapsulateBatch(data, count));
 }
 
 void Sender::encapsulateAndSave(const application::Data& data, const std::string& filename) {
     auto frameBytes = encapsulate(data);
     
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
-        throw std::runtime_error("Failed to open file for writing: " + filename);
+    if (io::isPcapFile(filename)) {
+        io::PcapWriter writer(filename);
+        writer.write(frameBytes);
+        writer.close();
+    } else {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Failed to open file for writing: " + filename);
+        }
+        
+        file.write(reinterpret_cast<const char*>(frameBytes.data()), frameBytes.size());
+        file.close();
     }
     
-    file.write(reinterpret_cast<const char*>(frameBytes.data()), frameBytes.size());
-    file.close();
-    
-    std::cout << "\nPhysical Layer:" << std::endl;
-    std::cout << "  Saved to file: " << filename << std::endl;
-    std::cout << "  Total bytes written: " << frameBytes.size() << std::endl;
+    if (tracer_.enabled()) {
+        tracer_.file(trace::FileRecord{trace::Direction::Encapsulate, filename, frameBytes.size()});
+    }
 }
 
 Config Sender::defaultConfig() {
@@ -68,6 +329,8 @@ Config Sender::defaultConfig() {
     config.dstIP = network::IPv4Packet::parseIP("192.168.1.1");
     config.srcMAC = datalink::EthernetFrame::parseMAC("00:11:22:33:44:55");
     config.dstMAC = datalink::EthernetFrame::parseMAC("66:77:88:99:AA:BB");
+    config.srcIPv6 = network::IPv6Packet::parseAddress("fd00::100");
+    config.dstIPv6 = network::IPv6Packet::parseAddress("fd00::1");
     return config;
 }
 
@@ -0,0 +1,221 @@
+#include "trace/trace.h"
+#include "common/byte_view.h"
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+
+namespace trace {
+
+namespace {
+
+const char* directionName(Direction direction) {
+    return direction == Direction::Encapsulate ? "encap" : "decap";
+}
+
+std::string srcAddress(const PacketRecord& record) {
+    return record.isIPv6() ? "[" + network::IPv6Packet::addressToString(record.ipv6.srcIP) + "]"
+                           : network::IPv4Packet::ipToString(record.ipv4.srcIP);
+}
+
+std::string dstAddress(const PacketRecord& record) {
+    return record.isIPv6() ? "[" + network::IPv6Packet::addressToString(record.ipv6.dstIP) + "]"
+                           : network::IPv4Packet::ipToString(record.ipv4.dstIP);
+}
+
+// IP层总长度（IPv6为固定首部加载荷长度）
+uint16_t ipLength(const PacketRecord& record) {
+    return record.isIPv6() ? static_cast<uint16_t>(network::IPV6_HEADER_SIZE + record.ipv6.payloadLength)
+                           : record.ipv4.totalLength;
+}
+
+} // namespace
+
+void TextSink::packet(Level level, const PacketRecord& record) {
+    if (level == Level::Detail) {
+        if (record.direction == Direction::Encapsulate) {
+            encapsulateDetail(record);
+        } else {
+            decapsulateDetail(record);
+        }
+        return;
+    }
+    
+    out_ << directionName(record.direction) << " " << record.frameSize << " bytes "
+         << srcAddress(record) << ":" << record.udp.srcPort
+         << " -> " << dstAddress(record) << ":" << record.udp.dstPort
+         << " payload " << record.payload.size() << '\n';
+}
+
+void TextSink::file(Level level, const FileRecord& record) {
+    if (level != Level::Detail) {
+        return;
+    }
+    if (record.direction == Direction::Encapsulate) {
+        out_ << "\nPhysical Layer:\n"
+             << "  Saved to file: " << record.filename << '\n'
+             << "  Total bytes written: " << record.bytes << '\n';
+    } else {
+        out_ << "Reading file: " << record.filename << "\n\n";
+    }
+}
+
+void TextSink::encapsulateDetail(const PacketRecord& record) {
+    size_t payloadSize = record.payload.size();
+    out_ << "Application Layer - Data: " << record.payload.toString()
+         << " (" << payloadSize << " bytes)\n";
+    
+    out_ << "\nTransport Layer (UDP):\n"
+         << "  Source Port: " << record.udp.srcPort << '\n'
+         << "  Dest Port: " << record.udp.dstPort << '\n'
+         << "  UDP Length: " << record.udp.length << " bytes (header: 8 + data: "
+         << payloadSize << ")\n";
+    
+    if (record.isIPv6()) {
+        out_ << "\nNetwork Layer (IPv6):\n"
+             << "  Source IP: " << network::IPv6Packet::addressToString(record.ipv6.srcIP) << '\n'
+             << "  Dest IP: " << network::IPv6Packet::addressToString(record.ipv6.dstIP) << '\n'
+             << "  Next Header: UDP (" << static_cast<int>(record.ipv6.nextHeader) << ")\n"
+             << "  Payload Length: " << record.ipv6.payloadLength << " bytes (UDP: "
+             << record.udp.length << ")\n";
+    } else {
+        out_ << "\nNetwork Layer (IPv4):\n"
+             << "  Source IP: " << network::IPv4Packet::ipToString(record.ipv4.srcIP) << '\n'
+             << "  Dest IP: " << network::IPv4Packet::ipToString(record.ipv4.dstIP) << '\n'
+             << "  Protocol: UDP (" << static_cast<int>(record.ipv4.protocol) << ")\n"
+             << "  Total Length: " << record.ipv4.totalLength << " bytes (header: 20 + UDP: "
+             << record.udp.length << ")\n";
+    }
+    
+    out_ << "\nData Link Layer (Ethernet II):\n"
+         << "  Source MAC: " << datalink::EthernetFrame::macToString(record.ethernet.srcMAC) << '\n'
+         << "  Dest MAC: " << datalink::EthernetFrame::macToString(record.ethernet.dstMAC) << '\n'
+         << "  EtherType: 0x" << std::hex << std::setfill('0') << std::setw(4)
+         << record.ethernet.etherType << std::dec << (record.isIPv6() ? " (IPv6)\n" : " (IPv4)\n")
+         << "  Frame Size: " << record.frameSize << " bytes (header: 14 + IP: "
+         << ipLength(record) << ")\n";
+}
+
+void TextSink::decapsulateDetail(const PacketRecord& record) {
+    out_ << "=== Starting Decapsulation ===\n"
+         << "Total bytes received: " << record.frameSize << "\n\n";
+    
+    out_ << "--- Data Link Layer (Ethernet II) ---\n"
+         << "  Dest MAC: " << datalink::EthernetFrame::macToString(record.ethernet.dstMAC) << '\n'
+         << "  Source MAC: " << datalink::EthernetFrame::macToString(record.ethernet.srcMAC) << '\n'
+         << "  EtherType: 0x" << std::hex << std::setfill('0') << std::setw(4)
+         << record.ethernet.etherType << std::dec << '\n'
+         << (record.isIPv6() ? "  EtherType verified: IPv6\n" : "  EtherType verified: IPv4\n");
+    
+    if (record.isIPv6()) {
+        out_ << "\n--- Network Layer (IPv6) ---\n"
+             << "  Version: " << static_cast<int>(record.ipv6.version) << '\n'
+             << "  Payload Length: " << record.ipv6.payloadLength << " bytes\n"
+             << "  Hop Limit: " << static_cast<int>(record.ipv6.hopLimit) << '\n'
+             << "  Next Header: " << static_cast<int>(record.ipv6.nextHeader) << '\n'
+             << "  Source IP: " << network::IPv6Packet::addressToString(record.ipv6.srcIP) << '\n'
+             << "  Dest IP: " << network::IPv6Packet::addressToString(record.ipv6.dstIP) << '\n'
+             << "  Protocol verified: UDP (17)\n";
+    } else {
+        out_ << "\n--- Network Layer (IPv4) ---\n"
+             << "  Version: " << static_cast<int>(record.ipv4.version) << '\n'
+             << "  Header Length: " << (record.ipv4.ihl * 4) << " bytes\n"
+             << "  Total Length: " << record.ipv4.totalLength << " bytes\n"
+             << "  TTL: " << static_cast<int>(record.ipv4.ttl) << '\n'
+             << "  Protocol: " << static_cast<int>(record.ipv4.protocol) << '\n'
+             << "  Source IP: " << network::IPv4Packet::ipToString(record.ipv4.srcIP) << '\n'
+             << "  Dest IP: " << network::IPv4Packet::ipToString(record.ipv4.dstIP) << '\n'
+             << "  Protocol verified: UDP (17)\n";
+    }
+    
+    out_ << "\n--- Transport Layer (UDP) ---\n"
+         << "  Source Port: " << record.udp.srcPort << '\n'
+         << "  Dest Port: " << record.udp.dstPort << '\n'
+         << "  UDP Length: " << record.udp.length << " bytes\n"
+         << "  Checksum: 0x" << std::hex << std::setfill('0') << std::setw(4)
+         << record.udp.checksum << std::dec << '\n';
+    
+    out_ << "\n--- Application Layer ---\n"
+         << "  Data: " << record.payload.toString() << '\n'
+         << "  Size: " << record.payload.size() << " bytes\n";
+    
+    out_ << "\n=== Decapsulation Complete ===\n";
+}
+
+void BinarySink::packet(Level, const PacketRecord& record) {
+    // 记录布局：
+    //   0 类型(1=数据包) 1 方向 2 保留 4 帧长度 8 时间戳(ns)
+    //  16 目的MAC 22 源MAC 28 EtherType 30 IP总长度 32 源IP 36 目的IP
+    //  40 源端口 42 目的端口 44 协议 45 TTL 46 UDP校验和
+    // IPv6数据包的源/目的IP记为0（以EtherType区分），协议与TTL取下一首部与跳数限制
+    uint8_t buf[PACKET_RECORD_SIZE] = {};
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    
+    buf[0] = 1;
+    buf[1] = static_cast<uint8_t>(record.direction);
+    common::storeLE32(buf + 4, static_cast<uint32_t>(record.frameSize));
+    common::storeLE64(buf + 8, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    std::copy(record.ethernet.dstMAC.begin(), record.ethernet.dstMAC.end(), buf + 16);
+    std::copy(record.ethernet.srcMAC.begin(), record.ethernet.srcMAC.end(), buf + 22);
+    common::storeLE16(buf + 28, record.ethernet.etherType);
+    common::storeLE16(buf + 30, ipLength(record));
+    if (record.isIPv6()) {
+        buf[44] = record.ipv6.nextHeader;
+        buf[45] = record.ipv6.hopLimit;
+    } else {
+        std::copy(record.ipv4.srcIP.begin(), record.ipv4.srcIP.end(), buf + 32);
+        std::copy(record.ipv4.dstIP.begin(), record.ipv4.dstIP.end(), buf + 36);
+        buf[44] = record.ipv4.protocol;
+        buf[45] = record.ipv4.ttl;
+    }
+    common::storeLE16(buf + 40, record.udp.srcPort);
+    common::storeLE16(buf + 42, record.udp.dstPort);
+    common::storeLE16(buf + 46, record.udp.checksum);
+    
+    out_.write(reinterpret_cast<const char*>(buf), sizeof(buf));
+}
+
+void BinarySink::file(Level, const FileRecord&) {
+    // 二进制格式只记录数据包
+}
+
+PacketRecord makeRecord(Direction direction, const datalink::EthernetView& ethernet,
+                        const network::IPv4View& ipv4, const transport::UDPView& udp) {
+    PacketRecord record;
+    record.direction = direction;
+    record.frameSize = ethernet.bytes().size();
+    record.ethernet = ethernet.header();
+    record.ipv4 = ipv4.header();
+    record.ipv6 = network::IPv6Header{};
+    record.udp = udp.header();
+    record.payload = udp.payload();
+    return record;
+}
+
+PacketRecord makeRecord(Direction direction, const datalink::EthernetView& ethernet,
+                        const network::IPv6View& ipv6, const transport::UDPView& udp) {
+    PacketRecord record;
+    record.direction = direction;
+    record.frameSize = ethernet.bytes().size();
+    record.ethernet = ethernet.header();
+    record.ipv4 = network::IPv4Header{};
+    record.ipv6 = ipv6.header();
+    record.udp = udp.header();
+    record.payload = udp.payload();
+    return record;
+}
+
+Level parseLevel(const std::string& name) {
+    if (name == "off") {
+        return Level::Off;
+    }
+    if (name == "summary") {
+        return Level::Summary;
+    }
+    if (name == "detail") {
+        return Level::Detail;
+    }
+    throw std::runtime_error("Invalid trace level: " + name);
+}
+
+} // namespace trace
@@ -0,0 +1,165 @@
+#include "transport/tcp.h"
+#include "common/checksum.h"
+#include <sstream>
+#include <iomanip>
+
+namespace transport {
+
+namespace {
+
+// 伪首部（长度为0）+首部+数据的部分和是否校验通过
+bool segmentSumValid(uint32_t pseudoSum, common::ByteView segment) {
+    size_t length = segment.size();
+    uint32_t sum = common::checksumAdd(pseudoSum, static_cast<uint32_t>(length >> 16));
+    sum = common::checksumAdd(sum, static_cast<uint32_t>(length & 0xFFFF));
+    sum = common::checksumPartial(segment.data(), segment.size(), sum);
+    return common::checksumFinish(sum) == 0;
+}
+
+} // namespace
+
+TCPSegment::TCPSegment(uint16_t srcPort, uint16_t dstPort, uint32_t seq, uint32_t ack, uint16_t flags,
+                       const std::vector<uint8_t>& payload)
+    : payload_(payload) {
+    header_.srcPort = srcPort;
+    header_.dstPort = dstPort;
+    header_.seq = seq;
+    header_.ack = ack;
+    header_.dataOffset = TCP_HEADER_SIZE / 4;
+    header_.flags = flags;
+    header_.window = TCP_DEFAULT_WINDOW;
+    header_.checksum = 0;
+    header_.urgentPointer = 0;
+}
+
+TCPSegment::TCPSegment(const TCPView& view)
+    : header_(view.header()), payload_(view.payload()) {
+    header_.dataOffset = TCP_HEADER_SIZE / 4;
+}
+
+std::vector<uint8_t> TCPSegment::encode() const {
+    std::vector<uint8_t> buf(TCP_HEADER_SIZE + payload_.size());
+
+    encodeHeader(header_, buf.data());
+
+    common::ByteView payload = payload_.view();
+    std::copy(payload.begin(), payload.end(), buf.begin() + TCP_HEADER_SIZE);
+
+    return buf;
+}
+
+uint16_t TCPSegment::calculateChecksum(uint32_t pseudoSum, const TCPHeader& header,
+                                       uint32_t payloadSum, size_t payloadLen) {
+    TCPHeader zeroed = header;
+    zeroed.checksum = 0;
+    uint8_t encoded[TCP_HEADER_SIZE] = {};
+    encodeHeader(zeroed, encoded);
+
+    size_t length = TCP_HEADER_SIZE + payloadLen;
+    uint32_t sum = common::checksumAdd(pseudoSum, static_cast<uint32_t>(length >> 16));
+    sum = common::checksumAdd(sum, static_cast<uint32_t>(length & 0xFFFF));
+    sum = common::checksumPartial(encoded, TCP_HEADER_SIZE, sum);
+    sum = common::checksumAdd(sum, payloadSum);
+    return common::checksumFinish(sum);
+}
+
+void TCPSegment::updateChecksum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) {
+    uint32_t payloadSum = common::checksumPartial(payload_.view().data(), payload_.size());
+    header_.checksum = calculateChecksum(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_TCP, 0),
+                                         header_, payloadSum, payload_.size());
+}
+
+void TCPSegment::updateChecksum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) {
+    uint32_t payloadSum = common::checksumPartial(payload_.view().data(), payload_.size());
+    header_.checksum = calculateChecksum(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_TCP, 0),
+                                         header_, payloadSum, payload_.size());
+}
+
+TCPSegment TCPSegment::decode(common::ByteView data) {
+    return TCPSegment(TCPView::parse(data));
+}
+
+common::DecodeStatus TCPSegment::tryDecode(common::ByteView data, TCPSegment& out) {
+    TCPView view;
+    common::DecodeStatus status = TCPView::tryParse(data, view);
+    if (status == common::DecodeStatus::Ok) {
+        out = TCPSegment(view);
+    }
+    return status;
+}
+
+TCPView TCPView::parse(common::ByteView data) {
+    TCPView view;
+    common::DecodeStatus status = tryParse(data, view);
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
+    }
+    return view;
+}
+
+common::DecodeStatus TCPView::tryParse(common::ByteView data, TCPView& out) noexcept {
+    if (data.size() < TCP_HEADER_SIZE) {
+        return common::DecodeStatus::TCPTooShort;
+    }
+
+    size_t headerLength = static_cast<size_t>(fields::DataOffset::get(data.data())) * 4;
+    if (headerLength < TCP_HEADER_SIZE || headerLength > data.size()) {
+        return common::DecodeStatus::BadTCPDataOffset;
+    }
+
+    out = TCPView(data);
+    return common::DecodeStatus::Ok;
+}
+
+bool TCPView::checksumValid(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) const {
+    return segmentSumValid(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_TCP, 0), data_);
+}
+
+bool TCPView::checksumValid(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) const {
+    return segmentSumValid(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_TCP, 0), data_);
+}
+
+std::vector<uint8_t> TCPSegment::getPayload() const {
+    return payload_.toVector();
+}
+
+TCPHeader TCPSegment::getHeader() const {
+    return header_;
+}
+
+std::string TCPSegment::flagsToString(uint16_t flags) {
+    static const struct {
+        uint16_t bit;
+        const char* name;
+    } names[] = {
+        {TCP_FLAG_SYN, "SYN"}, {TCP_FLAG_ACK, "ACK"}, {TCP_FLAG_PSH, "PSH"},
+        {TCP_FLAG_URG, "URG"}, {TCP_FLAG_RST, "RST"}, {TCP_FLAG_FIN, "FIN"},
+    };
+
+    std::string text;
+    for (const auto& entry : names) {
+        if (flags & entry.bit) {
+            if (!text.empty()) {
+                text += '|';
+            }
+            text += entry.name;
+        }
+    }
+    return text.empty() ? "none" : text;
+}
+
+std::string TCPSegment::toString() const {
+    std::ostringstream oss;
+    oss << "TCP Segment:\n"
+        << "  Source Port: " << header_.srcPort << "\n"
+        << "  Dest Port: " << header_.dstPort << "\n"
+        << "  Sequence: " << header_.seq << "\n"
+        << "  Acknowledgment: " << header_.ack << "\n"
+        << "  Flags: " << flagsToString(header_.flags) << "\n"
+        << "  Window: " << header_.window << "\n"
+        << "  Checksum: 0x" << std::hex << std::setfill('0') << std::setw(4) << header_.checksum << "\n"
+        << "  Payload Size: " << std::dec << payload_.size() << " bytes";
+    return oss.str();
+}
+
+} // namespace transport
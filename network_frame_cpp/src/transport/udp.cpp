@@ -1,4 +1,5 @@
 #include "transport/udp.h"
+#include "common/checksum.h"
 #include <sstream>
 #include <iomanip>
 
@@ -12,51 +13,170 @@ UDPDatagram::UDPDatagram(uint16_t srcPort, uint16_t dstPort, const std::vector<u
     header_.checksum = 0;  // 校验和置0
 }
 
+UDPDatagram::UDPDatagram(const UDPView& view)
+    : header_(view.header()), payload_(view.payload()) {
+}
+
+UDPDatagram::UDPDatagram(const UDPView& view, common::ByteStorage payload)
+    : header_(view.header()), payload_(std::move(payload)) {
+}
+
 std::vector<uint8_t> UDPDatagram::encode() const {
     std::vector<uint8_t> buf(UDP_HEADER_SIZE + payload_.size());
     
-    // 写入UDP首部（大端/网络字节序）
-    buf[0] = (header_.srcPort >> 8) & 0xFF;
-    buf[1] = header_.srcPort & 0xFF;
-    buf[2] = (header_.dstPort >> 8) & 0xFF;
-    buf[3] = header_.dstPort & 0xFF;
-    buf[4] = (header_.length >> 8) & 0xFF;
-    buf[5] = header_.length & 0xFF;
-    buf[6] = (header_.checksum >> 8) & 0xFF;
-    buf[7] = header_.checksum & 0xFF;
+    encodeHeader(header_, buf.data());
     
     // 写入数据
-    std::copy(payload_.begin(), payload_.end(), buf.begin() + UDP_HEADER_SIZE);
+    common::ByteView payload = payload_.view();
+    std::copy(payload.begin(), payload.end(), buf.begin() + UDP_HEADER_SIZE);
     
     return buf;
 }
 
-UDPDatagram UDPDatagram::decode(const std::vector<uint8_t>& data) {
-    if (data.size() < UDP_HEADER_SIZE) {
-        throw std::runtime_error("Data too short for UDP header");
+namespace {
+
+UDPHeader makeHeader(uint16_t srcPort, uint16_t dstPort, size_t payloadSize) {
+    size_t length = UDP_HEADER_SIZE + payloadSize;
+    if (length > 0xFFFF) {
+        throw std::runtime_error("Payload too large for UDP datagram");
     }
     
-    UDPDatagram datagram;
-    
-    // 解析首部
-    datagram.header_.srcPort = (static_cast<uint16_t>(data[0]) << 8) | data[1];
-    datagram.header_.dstPort = (static_cast<uint16_t>(data[2]) << 8) | data[3];
-    datagram.header_.length = (static_cast<uint16_t>(data[4]) << 8) | data[5];
-    datagram.header_.checksum = (static_cast<uint16_t>(data[6]) << 8) | data[7];
-    
-    size_t payloadLen = datagram.header_.length - UDP_HEADER_SIZE;
-    if (data.size() < UDP_HEADER_SIZE + payloadLen) {
-        throw std::runtime_error("Invalid UDP length field");
+    UDPHeader header;
+    header.srcPort = srcPort;
+    header.dstPort = dstPort;
+    header.length = static_cast<uint16_t>(length);
+    header.checksum = 0;
+    return header;
+}
+
+} // namespace
+
+void UDPDatagram::prependHeader(common::PacketBuffer& buf, uint16_t srcPort, uint16_t dstPort,
+                                const network::IPv4Address& srcIP, const network::IPv4Address& dstIP,
+                                uint32_t payloadSum) {
+    UDPHeader header = makeHeader(srcPort, dstPort, buf.size());
+    header.checksum = calculateChecksum(srcIP, dstIP, header, payloadSum);
+    encodeHeader(header, buf.prepend(UDP_HEADER_SIZE));
+}
+
+void UDPDatagram::prependHeader(common::PacketBuffer& buf, uint16_t srcPort, uint16_t dstPort,
+                                const network::IPv6Address& srcIP, const network::IPv6Address& dstIP,
+                                uint32_t payloadSum) {
+    UDPHeader header = makeHeader(srcPort, dstPort, buf.size());
+    header.checksum = calculateChecksum(srcIP, dstIP, header, payloadSum);
+    encodeHeader(header, buf.prepend(UDP_HEADER_SIZE));
+}
+
+uint16_t UDPDatagram::calculateChecksum(const network::IPv4Address& srcIP,
+                                        const network::IPv4Address& dstIP,
+                                        const UDPHeader& header, uint32_t payloadSum) {
+    return calculateChecksum(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_UDP, header.length),
+                             header, payloadSum);
+}
+
+uint16_t UDPDatagram::calculateChecksum(const network::IPv6Address& srcIP,
+                                        const network::IPv6Address& dstIP,
+                                        const UDPHeader& header, uint32_t payloadSum) {
+    return calculateChecksum(pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_UDP, header.length),
+                             header, payloadSum);
+}
+
+uint16_t UDPDatagram::calculateChecksum(uint32_t pseudoSum, const UDPHeader& header, uint32_t payloadSum) {
+    uint32_t sum = common::checksumAdd(pseudoSum, header.srcPort);
+    sum = common::checksumAdd(sum, header.dstPort);
+    sum = common::checksumAdd(sum, header.length);
+    sum = common::checksumAdd(sum, payloadSum);
+    uint16_t checksum = common::checksumFinish(sum);
+    // 计算结果为0时以全1发送，0留作"未计算"
+    return checksum == 0 ? 0xFFFF : checksum;
+}
+
+void UDPDatagram::updateChecksum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) {
+    header_.checksum = 0;
+    uint32_t payloadSum = common::checksumPartial(payload_.view().data(), payload_.size());
+    header_.checksum = calculateChecksum(srcIP, dstIP, header_, payloadSum);
+}
+
+void UDPDatagram::updateChecksum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) {
+    header_.checksum = 0;
+    uint32_t payloadSum = common::checksumPartial(payload_.view().data(), payload_.size());
+    header_.checksum = calculateChecksum(srcIP, dstIP, header_, payloadSum);
+}
+
+uint32_t pseudoHeaderSum(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP,
+                         uint8_t protocol, uint16_t length) {
+    uint32_t sum = common::checksumPartial(srcIP.data(), srcIP.size());
+    sum = common::checksumPartial(dstIP.data(), dstIP.size(), sum);
+    sum = common::checksumAdd(sum, protocol);
+    return common::checksumAdd(sum, length);
+}
+
+uint32_t pseudoHeaderSum(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP,
+                         uint8_t protocol, uint32_t length) {
+    uint32_t sum = common::checksumPartial(srcIP.data(), srcIP.size());
+    sum = common::checksumPartial(dstIP.data(), dstIP.size(), sum);
+    sum = common::checksumAdd(sum, length >> 16);
+    sum = common::checksumAdd(sum, length & 0xFFFF);
+    return common::checksumAdd(sum, protocol);
+}
+
+UDPDatagram UDPDatagram::decode(common::ByteView data) {
+    return UDPDatagram(UDPView::parse(data));
+}
+
+common::DecodeStatus UDPDatagram::tryDecode(common::ByteView data, UDPDatagram& out) {
+    UDPView view;
+    common::DecodeStatus status = UDPView::tryParse(data, view);
+    if (status == common::DecodeStatus::Ok) {
+        out = UDPDatagram(view);
+    }
+    return status;
+}
+
+UDPView UDPView::parse(common::ByteView data) {
+    UDPView view;
+    common::DecodeStatus status = tryParse(data, view);
+    if (status != common::DecodeStatus::Ok) {
+        common::throwDecodeError(status);
+    }
+    return view;
+}
+
+common::DecodeStatus UDPView::tryParse(common::ByteView data, UDPView& out) noexcept {
+    if (data.size() < UDP_HEADER_SIZE) {
+        return common::DecodeStatus::UDPTooShort;
     }
     
-    datagram.payload_.assign(data.begin() + UDP_HEADER_SIZE, 
-                              data.begin() + UDP_HEADER_SIZE + payloadLen);
+    uint16_t length = fields::Length::get(data.data());
+    if (length < UDP_HEADER_SIZE || data.size() < length) {
+        return common::DecodeStatus::BadUDPLength;
+    }
     
-    return datagram;
+    out = UDPView(data.subview(0, length));
+    return common::DecodeStatus::Ok;
+}
+
+bool UDPView::checksumValid(const network::IPv4Address& srcIP, const network::IPv4Address& dstIP) const {
+    if (checksum() == 0) {
+        return true;
+    }
+    // 包含校验和字段在内的反码和应为全1
+    uint32_t sum = pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_UDP, length());
+    sum = common::checksumPartial(data_.data(), data_.size(), sum);
+    return common::checksumFinish(sum) == 0;
+}
+
+bool UDPView::checksumValid(const network::IPv6Address& srcIP, const network::IPv6Address& dstIP) const {
+    if (checksum() == 0) {
+        return false;
+    }
+    uint32_t sum = pseudoHeaderSum(srcIP, dstIP, network::PROTOCOL_UDP, length());
+    sum = common::checksumPartial(data_.data(), data_.size(), sum);
+    return common::checksumFinish(sum) == 0;
 }
 
 std::vector<uint8_t> UDPDatagram::getPayload() const {
-    return payload_;
+    return payload_.toVector();
 }
 
 UDPHeader UDPDatagram::getHeader() const {